@@ -0,0 +1,123 @@
+#ifndef CPPDICT_BENCH_DATA_HPP
+#define CPPDICT_BENCH_DATA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "attr.hpp"
+#include "entry.hpp"
+
+// Trees modeled on test/data.hpp make_data(), scaled by
+// - width: children per node
+// - depth: levels of nested nodes
+// - size: records per node and items of the root collection
+
+class BenchRecord {
+ public:
+  static constexpr auto EntryName = "Record";
+
+  BenchRecord() = default;
+
+  explicit BenchRecord(std::size_t index)
+    : _value(static_cast<int>(index * 7919))
+    , _name("record-" + std::to_string(index)) {}
+
+  void serialize(auto& serializer) const {
+    using std::cref;
+    serializer.serialize(makeEntry<"Int">(cref(_value)), //
+                         makeEntry<"Str">(cref(_name)));
+  }
+
+  void deserialize(auto& deserializer) {
+    using std::ref;
+    deserializer.deserialize(makeEntry<"Int">(ref(_value)), //
+                             makeEntry<"Str">(ref(_name)));
+  }
+
+ private:
+  int _value{};
+  std::string _name;
+};
+
+class BenchNode {
+ public:
+  static constexpr auto EntryName = "Node";
+
+  BenchNode() = default;
+
+  BenchNode(std::size_t width, std::size_t depth, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      _records.emplace_back(i);
+    }
+    if (depth > 1) {
+      _children.assign(width, BenchNode(width, depth - 1, size));
+    }
+  }
+
+  void serialize(auto& serializer) const {
+    using std::cref;
+    serializer.serialize(makeEntry<"Int">(cref(_value)), //
+                         makeEntry<"Str">(cref(_name)),
+                         makeEntry<"Records">(cref(_records)),
+                         makeEntry<"Children">(cref(_children)));
+  }
+
+  void deserialize(auto& deserializer) {
+    using std::ref;
+    deserializer.deserialize(makeEntry<"Int">(ref(_value)), //
+                             makeEntry<"Str">(ref(_name)),
+                             makeEntry<"Records">(ref(_records)),
+                             makeEntry<"Children">(ref(_children)));
+  }
+
+  // Nodes and records held by this subtree
+  std::size_t records() const {
+    std::size_t count = 1 + _records.size();
+    for (const auto& child : _children) {
+      count += child.records();
+    }
+    return count;
+  }
+
+ private:
+  int _value{ 42 };
+  std::string _name{ "Node" };
+  std::vector<BenchRecord> _records;
+  std::vector<BenchNode> _children;
+};
+
+inline auto make_bench_data(std::size_t width, std::size_t depth, std::size_t size) {
+  std::vector<int> samples(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    samples[i] = static_cast<int>(i * i);
+  }
+
+  return makeEntry<"Root">(
+    std::tuple{
+      makeEntry<"Int">(5, makeAttr<"ENABLE">(true)),
+      makeEntry<"Str">("Test"),
+      makeEntry<"Node">(BenchNode(width, depth, size)),
+      makeEntry<"Vec">(std::move(samples)),
+      makeEntry<"Child">(std::tuple{
+        makeEntry<"Bool">(true, makeAttr<"TEST">(15)),
+      }),
+    },
+    makeAttr<"IsRoot">(true));
+}
+
+// Millisecond timestamps sampled at a slightly irregular rate
+inline std::vector<std::int64_t> make_bench_series(std::size_t size) {
+  std::vector<std::int64_t> series(size);
+  std::int64_t timestamp = 1'700'000'000'000;
+  for (std::size_t i = 0; i < size; ++i) {
+    timestamp += 10 + static_cast<std::int64_t>(i * 7919 % 13);
+    series[i] = timestamp;
+  }
+  return series;
+}
+
+#endif // !CPPDICT_BENCH_DATA_HPP
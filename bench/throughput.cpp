@@ -0,0 +1,315 @@
+#include "./data.hpp"
+
+#include "deserializer.hpp"
+#include "encoding.hpp"
+#include "lazy.hpp"
+#include "serializer.hpp"
+#include "serializer/binary.hpp"
+#include "serializer/stdcio.hpp"
+
+#ifdef CPPDICT_QTXML_SERIALIZER
+#include "serializer/qtxml.hpp"
+
+#include <QBuffer>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct BinaryBackend {
+  std::size_t serialize(const auto& tree) {
+    _buffer->clear();
+    Serializer serializer(BinaryWriter{ _buffer });
+    serializer.serialize(tree);
+    return _buffer->size();
+  }
+
+  void deserialize(auto& tree) {
+    Deserializer deserializer(BinaryReader{ *_buffer });
+    deserializer.deserialize(tree);
+  }
+
+  std::string_view buffer() const {
+    return *_buffer;
+  }
+
+ private:
+  std::shared_ptr<std::string> _buffer = std::make_shared<std::string>();
+};
+
+#ifdef CPPDICT_QTXML_SERIALIZER
+struct QtXmlBackend {
+  QtXmlBackend() {
+    _buffer.open(QBuffer::ReadWrite);
+  }
+
+  std::size_t serialize(const auto& tree) {
+    _buffer.buffer().clear();
+    _buffer.seek(0);
+    Serializer serializer(QtStreamWriter{ std::make_shared<QXmlStreamWriter>(&_buffer) });
+    serializer.serialize(tree);
+    return _buffer.data().size();
+  }
+
+  void deserialize(auto& tree) {
+    auto reader = std::make_shared<QXmlStreamReader>();
+    reader->addData(_buffer.data());
+    Deserializer deserializer(QtStreamReader{ std::move(reader) });
+    deserializer.deserialize(tree);
+  }
+
+ private:
+  QBuffer _buffer;
+};
+#endif
+
+// StdCout always targets std::cout, which is redirected to memory
+struct StdCioBackend {
+  std::size_t serialize(const auto& tree) {
+    _sink.str({});
+    auto* const saved = std::cout.rdbuf(_sink.rdbuf());
+    Serializer serializer(StdCout{});
+    serializer.serialize(tree);
+    std::cout.rdbuf(saved);
+    return _sink.view().size();
+  }
+
+ private:
+  std::ostringstream _sink;
+};
+
+struct StdBufferedBackend {
+  std::size_t serialize(const auto& tree) {
+    _buffer->clear();
+    Serializer serializer(StdBufferedWriter{ StringSink{ _buffer } });
+    serializer.serialize(tree);
+    return _buffer->size();
+  }
+
+ private:
+  std::shared_ptr<std::string> _buffer = std::make_shared<std::string>();
+};
+
+auto makeTree(const benchmark::State& state) {
+  return make_bench_data(state.range(0), state.range(1), state.range(2));
+}
+
+std::size_t records(auto& tree) {
+  return tree.template get<"Root/Node">().records() + tree.template get<"Root/Vec">().size();
+}
+
+void setCounters(benchmark::State& state, std::size_t bytes, std::size_t records) {
+  const auto iterations = static_cast<double>(state.iterations());
+  state.SetBytesProcessed(static_cast<std::int64_t>(bytes * state.iterations()));
+  state.counters["records/s"] =
+    benchmark::Counter(records * iterations, benchmark::Counter::kIsRate);
+  state.counters["bytes"] = static_cast<double>(bytes);
+}
+
+template<typename Backend>
+void serialize(benchmark::State& state) {
+  Backend backend;
+  auto tree = makeTree(state);
+
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    bytes = backend.serialize(tree);
+  }
+  setCounters(state, bytes, records(tree));
+}
+
+template<typename Backend>
+void deserialize(benchmark::State& state) {
+  Backend backend;
+  auto tree = makeTree(state);
+  const auto bytes = backend.serialize(tree);
+
+  for (auto _ : state) {
+    auto target = make_bench_data(0, 0, 0);
+    backend.deserialize(target);
+    benchmark::DoNotOptimize(target);
+  }
+  setCounters(state, bytes, records(tree));
+}
+
+template<typename Backend>
+void roundTrip(benchmark::State& state) {
+  Backend backend;
+  auto tree = makeTree(state);
+
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    bytes = backend.serialize(tree);
+    backend.deserialize(tree);
+  }
+  setCounters(state, bytes, records(tree));
+}
+
+// Decode a couple of fields out of the message, by skipping the rest or through an index
+void binaryPath(benchmark::State& state) {
+  BinaryBackend backend;
+  auto tree = makeTree(state);
+  const auto bytes = backend.serialize(tree);
+
+  for (auto _ : state) {
+    Deserializer deserializer(BinaryReader{ backend.buffer() });
+    deserializer.deserializePath<"Root/Child/Bool">(tree);
+    benchmark::DoNotOptimize(tree);
+  }
+  setCounters(state, bytes, 1);
+}
+
+void binaryLazy(benchmark::State& state) {
+  BinaryBackend backend;
+  const auto bytes = backend.serialize(makeTree(state));
+  BinaryIndex index;
+
+  for (auto _ : state) {
+    index.build(backend.buffer());
+    LazyTree lazy(make_bench_data(0, 0, 0), index);
+    benchmark::DoNotOptimize(lazy.get<"Root/Int">());
+    benchmark::DoNotOptimize(lazy.get<"Root/Child/Bool">());
+  }
+  setCounters(state, bytes, 2);
+}
+
+// One large collection of records split across threads, then spliced back in order
+void binaryParallel(benchmark::State& state) {
+  auto buffer = std::make_shared<std::string>();
+  auto tree = make_bench_data(1, 1, state.range(1));
+  const SerializerOptions options{ .threads = static_cast<std::size_t>(state.range(0)) };
+
+  for (auto _ : state) {
+    buffer->clear();
+    Serializer serializer(BinaryWriter{ buffer }, options);
+    serializer.serialize(tree);
+  }
+  setCounters(state, buffer->size(), records(tree));
+}
+
+void binaryParallelRead(benchmark::State& state) {
+  BinaryBackend backend;
+  auto tree = make_bench_data(1, 1, state.range(1));
+  const auto bytes = backend.serialize(tree);
+  const DeserializerOptions options{ .threads = static_cast<std::size_t>(state.range(0)) };
+
+  for (auto _ : state) {
+    Deserializer deserializer(BinaryReader{ backend.buffer() }, options);
+    deserializer.deserialize(tree);
+  }
+  setCounters(state, bytes, records(tree));
+}
+
+// Reader of an older schema lacking Root/Node, skipped by scanning it or by its size prefix
+template<bool Sized>
+void binarySkip(benchmark::State& state) {
+  auto buffer = std::make_shared<std::string>();
+  Serializer serializer(BinaryWriter{ buffer, BinaryWriterOptions{ .sizedObjects = Sized } });
+  serializer.serialize(makeTree(state));
+
+  int value = 0;
+  for (auto _ : state) {
+    Deserializer deserializer(BinaryReader{ *buffer });
+    deserializer.deserialize(makeEntry<"Root">(std::tuple{
+      makeEntry<"Int">(std::ref(value)),
+    }));
+    benchmark::DoNotOptimize(value);
+  }
+  setCounters(state, buffer->size(), 1);
+}
+
+// Timestamp series, mostly small increments, through each integer block encoding
+template<typename Encoding>
+void telemetry(benchmark::State& state) {
+  BinaryBackend backend;
+  const auto samples = make_bench_series(state.range(0));
+  const auto bytes = backend.serialize(makeEntry<"Series">(samples, Encoding{}));
+
+  auto target = makeEntry<"Series">(std::vector<std::int64_t>{});
+  for (auto _ : state) {
+    backend.deserialize(target);
+    benchmark::DoNotOptimize(target);
+  }
+  setCounters(state, bytes, samples.size());
+}
+
+// Fresh collection of strings per message, allocated from the heap or from an arena
+// released at once with the message
+template<bool Arena>
+void strings(benchmark::State& state) {
+  BinaryBackend backend;
+  std::vector<std::string> values(state.range(0));
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = "a record name longer than the inline buffer " + std::to_string(i);
+  }
+  const auto bytes = backend.serialize(makeEntry<"Strings">(std::cref(values)));
+
+  std::vector<std::byte> storage(4 * bytes);
+  for (auto _ : state) {
+    if constexpr (Arena) {
+      std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size());
+      auto target = makeEntry<"Strings">(std::pmr::vector<std::pmr::string>(&arena));
+      backend.deserialize(target);
+      benchmark::DoNotOptimize(target);
+    } else {
+      auto target = makeEntry<"Strings">(std::vector<std::string>{});
+      backend.deserialize(target);
+      benchmark::DoNotOptimize(target);
+    }
+  }
+  setCounters(state, bytes, values.size());
+}
+
+// width, depth, collection size
+void treeShapes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({ "width", "depth", "size" });
+  benchmark->Args({ 2, 2, 2 });
+  benchmark->Args({ 4, 3, 16 });
+  benchmark->Args({ 2, 6, 8 });
+  benchmark->Args({ 1, 1, 4096 });
+  benchmark->Args({ 8, 3, 256 });
+}
+
+BENCHMARK_TEMPLATE(serialize, BinaryBackend)->Apply(treeShapes);
+BENCHMARK_TEMPLATE(deserialize, BinaryBackend)->Apply(treeShapes);
+BENCHMARK_TEMPLATE(roundTrip, BinaryBackend)->Apply(treeShapes);
+BENCHMARK(binaryPath)->Apply(treeShapes);
+BENCHMARK(binaryLazy)->Apply(treeShapes);
+BENCHMARK(binaryParallel)
+  ->ArgNames({ "threads", "size" })
+  ->Args({ 1, 65536 })
+  ->Args({ 4, 65536 })
+  ->UseRealTime();
+BENCHMARK(binaryParallelRead)
+  ->ArgNames({ "threads", "size" })
+  ->Args({ 1, 65536 })
+  ->Args({ 4, 65536 })
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(binarySkip, false)->Apply(treeShapes);
+BENCHMARK_TEMPLATE(binarySkip, true)->Apply(treeShapes);
+BENCHMARK_TEMPLATE(telemetry, RawEncoding)->Arg(100000);
+BENCHMARK_TEMPLATE(telemetry, DeltaEncoding)->Arg(100000);
+BENCHMARK_TEMPLATE(telemetry, PackedEncoding)->Arg(100000);
+BENCHMARK_TEMPLATE(strings, false)->Arg(10000);
+BENCHMARK_TEMPLATE(strings, true)->Arg(10000);
+
+#ifdef CPPDICT_QTXML_SERIALIZER
+BENCHMARK_TEMPLATE(serialize, QtXmlBackend)->Apply(treeShapes);
+BENCHMARK_TEMPLATE(deserialize, QtXmlBackend)->Apply(treeShapes);
+BENCHMARK_TEMPLATE(roundTrip, QtXmlBackend)->Apply(treeShapes);
+#endif
+
+// StdCin is an interactive prompt, only the writer can be measured
+BENCHMARK_TEMPLATE(serialize, StdCioBackend)->Apply(treeShapes);
+BENCHMARK_TEMPLATE(serialize, StdBufferedBackend)->Apply(treeShapes);
+
+BENCHMARK_MAIN();
@@ -2,6 +2,8 @@
 #define CPPDICT_ATTR_HPP
 
 #include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include "stringLiteral.hpp"
@@ -24,4 +26,36 @@ constexpr auto makeAttr(const Type& type) {
   return Attr<Name, Type>(type);
 }
 
+namespace Detail {
+
+  template<typename T>
+  struct IsAttrType : std::false_type {};
+
+  template<StringLiteral Name, typename T>
+  struct IsAttrType<Attr<Name, T>> : std::true_type {};
+
+  template<typename T>
+  concept IsAttr = IsAttrType<std::remove_cvref_t<T>>::value;
+
+  template<typename... Attrs>
+  constexpr bool hasAttrs = (IsAttr<Attrs> || ...);
+
+  // References to the attributes held by an entry, leaving out other tags such as encodings
+  template<typename Attrs>
+  constexpr auto attrRefs(Attrs& attrs) {
+    return std::apply(
+      [](auto&... attrs) {
+        return std::tuple_cat([](auto& attr) {
+          if constexpr (IsAttr<decltype(attr)>) {
+            return std::tuple<decltype(attr)>(attr);
+          } else {
+            return std::tuple<>{};
+          }
+        }(attrs)...);
+      },
+      attrs);
+  }
+
+} // namespace Detail
+
 #endif // !CPPDICT_ATTR_HPP
@@ -0,0 +1,128 @@
+#ifndef CPPDICT_COLUMNS_HPP
+#define CPPDICT_COLUMNS_HPP
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "concepts.hpp"
+#include "entry.hpp"
+#include "stringLiteral.hpp"
+
+// Collections of user records stored column by column: each field the records declare
+// becomes one collection entry holding its value for every record.
+namespace Detail {
+
+  // Column holding the values of a record field
+  template<typename Field>
+  struct ColumnOfType;
+
+  template<StringLiteral Name, typename T, typename... Attrs>
+  struct ColumnOfType<Entry<Name, T, Attrs...>> {
+    using Value = std::remove_cvref_t<std::unwrap_reference_t<T>>;
+    using type = Entry<Name, std::vector<Value>>;
+  };
+
+  template<typename Field>
+  using ColumnOf = typename ColumnOfType<std::remove_cvref_t<Field>>::type;
+
+  // Fields holding a single item per record. Records with collection or tuple fields
+  // are stored row by row instead.
+  template<typename Field>
+  concept ColumnField = !SerializableRange<typename ColumnOfType<Field>::Value> &&
+    !EntryTuple<typename ColumnOfType<Field>::Value>;
+
+  // Serializer or deserializer handed to a record, calling visitor with the fields of its
+  // first serialize() or deserialize() call. Records must declare all their fields at once.
+  template<typename Visitor>
+  class FieldsProbe {
+   public:
+    explicit FieldsProbe(Visitor visitor)
+      : _visitor(std::move(visitor)) {}
+
+    template<typename... Fields>
+    void serialize(const Fields&... fields) {
+      this->visit(fields...);
+    }
+
+    template<typename... Fields>
+    void deserialize(Fields&&... fields) {
+      this->visit(fields...);
+    }
+
+   private:
+    template<typename... Fields>
+    void visit(Fields&... fields) {
+      if (!_visited) {
+        _visited = true;
+        _visitor(fields...);
+      }
+    }
+
+   private:
+    Visitor _visitor;
+    bool _visited{};
+  };
+
+  // Serializer appending the fields of each record to their column
+  template<typename... Fields>
+  class ColumnGather {
+   public:
+    explicit ColumnGather(std::size_t size)
+      : columns(ColumnOf<Fields>({})...) {
+      std::apply([size](auto&... columns) { (columns.value.reserve(size), ...); }, columns);
+    }
+
+    void serialize(const Fields&... fields) {
+      std::apply(
+        [&fields...](auto&... columns) {
+          (columns.value.push_back(unwrapRef(fields.value)), ...);
+        },
+        columns);
+    }
+
+   public:
+    std::tuple<ColumnOf<Fields>...> columns;
+  };
+
+  // Fields whose value the record lends through std::ref, outliving its deserialize() call
+  template<typename Field>
+  concept BorrowedField =
+    !std::is_same_v<std::unwrap_reference_t<typename Field::type>, typename Field::type>;
+
+  // Deserializer pointing at the value of a record's field of type Field
+  template<BorrowedField Field>
+  class FieldPointer {
+   public:
+    using Value = typename ColumnOfType<Field>::Value;
+
+    template<typename... Fields>
+    void deserialize(Fields&&... fields) {
+      (this->visit(fields), ...);
+    }
+
+   public:
+    Value* value{};
+
+   private:
+    void visit(Field& field) {
+      value = &unwrapRef(field.value);
+    }
+
+    void visit(auto&) {}
+  };
+
+  // Value of a record's field of type Field, found through the record's deserialize()
+  template<BorrowedField Field>
+  auto& fieldOf(auto& record) {
+    FieldPointer<Field> pointer;
+    record.deserialize(pointer);
+    return *pointer.value;
+  }
+
+} // namespace Detail
+
+#endif // !CPPDICT_COLUMNS_HPP
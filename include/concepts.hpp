@@ -2,9 +2,13 @@
 #define CPPDICT_CONCEPTS_HPP
 
 #include <concepts>
+#include <cstddef>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 
 template<typename T, typename Serializer>
 concept Serializable = requires(T obj, Serializer& serializer) {
@@ -29,12 +33,83 @@ namespace Detail {
     std::tuple_size<T>{};
   };
 
+  template<typename T>
+  struct IsEntryTupleType : std::false_type {};
+
+  template<typename... T>
+  struct IsEntryTupleType<std::tuple<T...>> : std::true_type {};
+
+  // Tuple of child entries, as opposed to other tuple-like values such as std::array
+  template<typename T>
+  concept EntryTuple = IsEntryTupleType<std::remove_cvref_t<T>>::value;
+
+  template<typename T>
+  concept StringLike = std::convertible_to<const T&, std::string_view>;
+
+  // Ranges the Serializer writes item by item: anything it can iterate, views which are
+  // only iterable when non-const (such as std::views::filter) being copied first
+  template<typename T>
+  concept SerializableRange = !StringLike<T> &&
+    (std::ranges::input_range<const T> ||
+     (std::ranges::view<T> && std::ranges::input_range<T> && std::copy_constructible<T>));
+
+  // Collections the Deserializer can grow item by item
   template<typename T>
   concept Collection =
     std::ranges::range<T> and not std::is_same_v<std::string, T> and requires(T value) {
     value.emplace_back();
   };
 
+  // Collections holding at most capacity() items, filled without ever growing past it
+  template<typename T>
+  concept FixedCapacity = Collection<T> && requires {
+    { T::capacity() } -> std::convertible_to<std::size_t>;
+  };
+
+  // Arrays of a size known at compile time such as std::array, decoded in place
+  template<typename T>
+  concept FixedArray =
+    std::ranges::random_access_range<T> && IsTuple<T> && !Collection<T> && !StringLike<T>;
+
+  template<typename T>
+  concept Number = (std::integral<T> || std::floating_point<T>) && !std::same_as<T, bool>;
+
+  // Collections of numbers laid out contiguously in memory, which backends may
+  // transfer as a single block instead of item by item
+  template<typename T>
+  concept NumberBlock = SerializableRange<T> && std::ranges::contiguous_range<const T> &&
+    std::ranges::sized_range<const T> && Number<std::ranges::range_value_t<T>>;
+
+  // Readers hand out entry names either as owned strings or as views into
+  // their input, which the Deserializer matches without allocating
+  template<typename T>
+  concept EntryNameReader = requires(T reader) {
+    { std::get<0>(reader.nextEntryName()) } -> std::convertible_to<std::string_view>;
+    { std::get<1>(reader.nextEntryName()) } -> std::convertible_to<bool>;
+  };
+
+  // Readers able to walk all attributes of an element in one pass, calling
+  // visitor(name, parse) for each of them where parse(value) decodes the attribute
+  template<typename T>
+  concept AttrBatchReader = requires(T reader) {
+    reader.readAttrs([](std::string_view, auto&&) {});
+  };
+
+  // Writers producing their output into a buffer, which fork() a writer positioned like them
+  // over a buffer of its own and splice() the output of such a fork back into theirs
+  template<typename T>
+  concept SpliceWriter = requires(T writer, const T& part) {
+    { part.fork() } -> std::same_as<T>;
+    writer.splice(part);
+  };
+
+  // Readers over an in-memory buffer, splitting the items left in the array they entered
+  // into consecutive runs read by readers of their own
+  template<typename T>
+  concept SplitReader = requires(T reader) {
+    { reader.splitArray(std::size_t{}) } -> std::same_as<std::vector<T>>;
+  };
+
   template<typename T, typename... U>
   concept IsAnyOf = (std::same_as<T, U> || ...);
 
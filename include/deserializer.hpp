@@ -1,81 +1,339 @@
 #ifndef CPPDICT_DESERIALIZER
 #define CPPDICT_DESERIALIZER
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <functional>
-#include <iostream>
+#include <future>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "columns.hpp"
 #include "concepts.hpp"
 #include "entry.hpp"
+#include "fixed.hpp"
+#include "nameTable.hpp"
+#include "path.hpp"
+#include "schema.hpp"
+#include "versioning.hpp"
 
-template<typename Reader>
+enum class CollectionMode {
+  Replace, // Clear collections before decoding their items
+  Reuse,   // Decode over the existing items, only constructing or trimming the tail
+};
+
+struct DeserializerOptions {
+  CollectionMode collections{ CollectionMode::Replace };
+  // Memory of the allocator-aware items, such as std::pmr::string, that the Deserializer
+  // adds to collections, and of the values it builds itself such as the items overflowing
+  // a fixed-capacity collection. std::pmr collections hand their own resource down to
+  // their items instead. Values already in the target keep their allocator.
+  std::pmr::memory_resource* resource{ std::pmr::get_default_resource() };
+  // Threads decoding the items of large arrays concurrently, with Readers satisfying
+  // Detail::SplitReader. Each thread decodes a run of items into slots sized up front.
+  // Arrays of allocator-aware items, or decoded with a resource other than the default one,
+  // are decoded on the calling thread since memory resources aren't synchronized. Items
+  // with std::pmr members of their own must give them a synchronized resource.
+  std::size_t threads{ 1 };
+  // Item count from which an array is split across threads
+  std::size_t parallelThreshold{ 4096 };
+  // Input is a patch such as written by Serializer::serializeDelta(), entries missing from it
+  // are left as is instead of being given their Default tag
+  bool patch{};
+};
+
+struct DeserializerStats {
+  std::size_t unknownEntries{}; // Entries skipped because no target matched their name
+};
+
+template<Detail::EntryNameReader Reader>
 class Deserializer {
  public:
-  Deserializer(Reader reader)
-    : _reader(std::move(reader)) {}
+  Deserializer(Reader reader, DeserializerOptions options = {})
+    : _reader(std::move(reader))
+    , _options(options) {}
 
+  // Decode entries by name. Input headed by the fingerprint of the same schema
+  // (see Serializer::serializeWithSchema) is decoded by position instead.
+  // Entries the input lacks are given their Default tag, if any.
   template<typename... Entries>
   void deserialize(Entries&&... entries) {
+    if constexpr (requires { _reader.readSchema(); }) {
+      if (!_started) {
+        _started = true;
+        if (_reader.readSchema() == Detail::schemaHash<Entries...>()) {
+          this->decodeInOrder(entries...);
+          return;
+        }
+      }
+    }
+
+    constexpr bool defaults = (Detail::DefaultedEntry<std::decay_t<Entries>> || ...);
+    [[maybe_unused]] std::array<bool, sizeof...(Entries)> found{};
     auto [name, valid] = _reader.nextEntryName();
 
     while (valid) {
-      if (!this->findEntry(name, entries...)) {
-        std::cerr << "Entry '" << name << "' not found" << std::endl;
-      };
+      const auto index = this->findEntry(name, entries...);
+      if (index == sizeof...(Entries)) {
+        this->skipEntry();
+      } else if constexpr (defaults) {
+        found[index] = true;
+      }
       std::tie(name, valid) = _reader.nextEntryName();
     }
+
+    if constexpr (defaults) {
+      if (_options.patch) {
+        return;
+      }
+      std::size_t index = 0;
+      ((found[index++] ? void() : this->applyDefault(entries)), ...);
+    }
+  }
+
+  // Decode only the entry or attribute at Path, e.g. "Root/Child/@Enabled", skipping
+  // every sibling subtree met on the way. Decoding stops once the target is read,
+  // the rest of the input is left unread. Returns whether Path was found.
+  template<StringLiteral Path, typename... Entries>
+  bool deserializePath(Entries&&... entries) {
+    return this->findPath<Path>(entries...);
+  }
+
+  // Decode the entry or attribute at Path from a reader positioned on that entry,
+  // such as the ones handed out by an offset index
+  template<StringLiteral Path, typename... Entries>
+  bool deserializeAt(Entries&&... entries) {
+    return this->decodeAt<Path>(entries...);
+  }
+
+  // Resource for the Deserializable classes allocating their own members while decoding
+  std::pmr::memory_resource* resource() const {
+    return _options.resource;
+  }
+
+  const DeserializerStats& stats() const {
+    return _stats;
+  }
+
+  // First error reported by the reader while decoding values, std::errc{} if none
+  std::errc error() const {
+    return _error;
   }
 
  private:
-  // Lookup entries by name
-  template<typename Entry, typename... Entries>
-  bool findEntry(const std::string& name, Entry& entry, Entries&... entries) {
-    if (this->matchEntry(entry, name)) {
-      this->processEntry(entry);
-      return true;
+  // Lookup entries by name through the pack's compile-time name table,
+  // returns the index of the entry decoded or the pack size when none matches
+  template<typename... Entries>
+  std::size_t findEntry(std::string_view name, Entries&... entries) {
+    constexpr auto& table = _nameTable<std::decay_t<Entries>...>;
+    const auto index = table.find(name);
+    if (index == table.npos) {
+      return index;
     }
 
-    if constexpr (sizeof...(entries) > 0) {
-      return this->findEntry(name, entries...);
+    this->visitAt(
+      index,
+      [this](auto& entry) { this->processEntry(entry); },
+      std::index_sequence_for<Entries...>{},
+      entries...);
+    return index;
+  }
+
+  template<Detail::DefaultedEntry T>
+  void applyDefault(T& entry) {
+    Detail::applyDefault(Detail::unwrapRef(entry.value), entry.attrs);
+    Detail::touch(entry.attrs);
+  }
+
+  void applyDefault(auto&) {}
+
+  // Walk the entries of the current level up to the one named after Path's first key
+  template<StringLiteral Path, typename... Entries>
+  bool findPath(Entries&... entries) {
+    using Split = Detail::PathSplit<Path>;
+    constexpr auto index = _nameTable<std::decay_t<Entries>...>.find(Split::key);
+    static_assert(index != sizeof...(Entries), "Key not found in entries");
+
+    auto [name, valid] = _reader.nextEntryName();
+    while (valid) {
+      if (name == std::string_view(Split::key)) {
+        return this->decodePath<Split::rest>(std::get<index>(std::tie(entries...)));
+      }
+      this->skipSubtree();
+      std::tie(name, valid) = _reader.nextEntryName();
     }
     return false;
   }
 
-  // Match entry by name
-  template<StringLiteral Name, typename T, typename... Attrs>
-  bool matchEntry(const Entry<Name, T, Attrs...>& entry, const std::string& name) const {
-    return name == entry.name;
+  // Resolve Path through the entries without reading, up to the entry the reader is on
+  template<StringLiteral Path, typename... Entries>
+  bool decodeAt(Entries&... entries) {
+    using Split = Detail::PathSplit<Path>;
+    constexpr auto index = _nameTable<std::decay_t<Entries>...>.find(Split::key);
+    static_assert(index != sizeof...(Entries), "Key not found in entries");
+
+    auto& entry = std::get<index>(std::tie(entries...));
+    if constexpr (Split::last || Detail::PathSplit<Split::rest>::attrKey) {
+      const auto [name, valid] = _reader.nextEntryName();
+      return valid && name == std::string_view(Split::key) &&
+             this->decodePath<Split::rest>(entry);
+    } else {
+      return std::apply(
+        [this](auto&... entries) { return this->decodeAt<Split::rest>(entries...); },
+        entry.value);
+    }
+  }
+
+  // Path fully matched, decode the entry
+  template<StringLiteral Path, typename T>
+  requires(Detail::PathSplit<Path>::view.empty()) bool decodePath(T& entry) {
+    this->processEntry(entry);
+    return true;
+  }
+
+  // Attribute of the matched entry
+  template<StringLiteral Path, StringLiteral Name, typename T, typename... Attrs>
+  requires(Detail::PathSplit<Path>::attrKey) bool decodePath(Entry<Name, T, Attrs...>& entry) {
+    constexpr std::string_view path = Path;
+    constexpr auto key = StringLiteral<path.size() - 1>(path.data() + 1); // Skip the @ prefix
+    return std::apply([this](auto&... attrs) { return this->decodeAttr<key>(attrs...); },
+                      Detail::attrRefs(entry.attrs));
+  }
+
+  template<StringLiteral Key, typename... Attrs>
+  bool decodeAttr(Attrs&... attrs) {
+    constexpr auto index = _nameTable<Attrs...>.find(Key);
+    static_assert(index != sizeof...(Attrs), "Attribute key not found in tuple");
+
+    this->processAttrs(std::get<index>(std::tie(attrs...)));
+    return true;
+  }
+
+  // Descend into the matched tuple entry
+  template<StringLiteral Path, StringLiteral Name, typename... Args, typename... Attrs>
+  requires(!Detail::PathSplit<Path>::view.empty() && !Detail::PathSplit<Path>::attrKey) //
+    bool decodePath(Entry<Name, std::tuple<Args...>, Attrs...>& entry) {
+    return std::apply([this](auto&... entries) { return this->findPath<Path>(entries...); },
+                      entry.value);
+  }
+
+  // Call visitor on the entry at index in the pack through a jump table
+  template<typename Visitor, std::size_t... Is, typename... Entries>
+  static void visitAt(std::size_t index,
+                      Visitor&& visitor,
+                      std::index_sequence<Is...>,
+                      Entries&... entries) {
+    using Refs = std::tuple<Entries&...>;
+    using Handler = void (*)(Visitor&, Refs&);
+    static constexpr Handler handlers[] = { [](Visitor& visitor, Refs& refs) {
+      visitor(std::get<Is>(refs));
+    }... };
+
+    Refs refs{ entries... };
+    handlers[index](visitor, refs);
+  }
+
+  // Name of an entry
+  template<typename T>
+  static constexpr std::string_view entryName() {
+    return T::name;
+  }
+
+  // Name of a Deserializable user class
+  template<Deserializable<Deserializer<Reader>> T>
+  static constexpr std::string_view entryName() {
+    return T::EntryName;
+  }
+
+  // Entries known to come in declaration order, decoded without looking up their names.
+  // Tuples are walked the same way, user classes decode their fields by name.
+  // Deprecated entries aren't written, they are only given their Default tag.
+  // Input ending early is reported, debug builds also check the name of every entry.
+  template<typename... Entries>
+  void decodeInOrder(Entries&... entries) {
+    bool valid = true;
+    [[maybe_unused]] const auto next = [this, &valid](auto& entry) {
+      using T = std::decay_t<decltype(entry)>;
+      if constexpr (Detail::Retired<T>) {
+        this->applyDefault(entry);
+        return;
+      }
+      if (!valid) {
+        return;
+      }
+      [[maybe_unused]] const auto [name, found] = _reader.nextEntryName();
+#ifndef NDEBUG
+      valid = found && name == entryName<T>();
+#else
+      valid = found;
+#endif
+      if (!valid) {
+        this->report(std::errc::invalid_argument);
+        return;
+      }
+      this->processInOrder(entry);
+    };
+    (next(entries), ...);
+
+    // Whatever follows the declared entries is skipped, such as the end of the object
+    while (valid && std::get<1>(_reader.nextEntryName())) {
+      this->skipEntry();
+    }
   }
 
-  // Match Deserializable user class by name
-  bool matchEntry(Deserializable<Deserializer<Reader>> auto& entry,
-                  const std::string& name) const {
-    return name == entry.EntryName;
+  template<StringLiteral Name, typename... Args, typename... Attrs>
+  void processInOrder(Entry<Name, std::tuple<Args...>, Attrs...>& entry) {
+    std::apply([this](auto&... attrs) { this->processAttrs(attrs...); },
+               Detail::attrRefs(entry.attrs));
+    std::apply([this](auto&... entries) { this->decodeInOrder(entries...); }, entry.value);
+  }
+
+  void processInOrder(auto& entry) {
+    this->processEntry(entry);
   }
 
   // Process a tuple entry
   template<StringLiteral Name, typename... Args, typename... Attrs>
   void processEntry(Entry<Name, std::tuple<Args...>, Attrs...>& entry) {
-    std::apply([this](auto&... attrs) { this->processAttrs(attrs...); }, entry.attrs);
+    if (this->skipColumns<std::tuple<Args...>>()) {
+      return;
+    }
+    std::apply([this](auto&... attrs) { this->processAttrs(attrs...); },
+               Detail::attrRefs(entry.attrs));
     std::apply([this](auto&... entries) { this->deserialize(entries...); }, entry.value);
   }
 
   // Process a simple entry
   template<StringLiteral Name, typename T, typename... Attrs>
   void processEntry(Entry<Name, T, Attrs...>& entry) {
-    std::apply([this](auto&... attrs) { this->processAttrs(attrs...); }, entry.attrs);
+    if (this->skipColumns<std::remove_cvref_t<decltype(Detail::unwrapRef(entry.value))>>()) {
+      return;
+    }
+    std::apply([this](auto&... attrs) { this->processAttrs(attrs...); },
+               Detail::attrRefs(entry.attrs));
     this->processEntry(entry.value);
+    Detail::touch(entry.attrs);
   }
 
   // Process an entry containing a Deserializable user class
   template<StringLiteral Name, Deserializable<Deserializer<Reader>> T, typename... Attrs>
   void processEntry(Entry<Name, T, Attrs...>& entry) {
-    std::apply([this](auto&... attrs) { this->processAttrs(attrs...); }, entry.attrs);
+    if (this->skipColumns<T>()) {
+      return;
+    }
+    std::apply([this](auto&... attrs) { this->processAttrs(attrs...); },
+               Detail::attrRefs(entry.attrs));
     entry.value.deserialize(*this);
+    Detail::touch(entry.attrs);
   }
 
   // Process a reference wrapper
@@ -91,39 +349,352 @@ class Deserializer {
 
   // Process a collection
   void processEntry(Detail::Collection auto& entries) {
-    entries.clear();
+    using Record = std::ranges::range_value_t<decltype(entries)>;
+    if constexpr (ColumnTarget<std::remove_cvref_t<decltype(entries)>> &&
+                  requires { _reader.columnCount(); }) {
+      if (const auto count = _reader.columnCount()) {
+        this->processColumns(entries, *count);
+        return;
+      }
+    }
+
+    if constexpr (requires { _reader.readArrayBlock(entries); }) {
+      if (_reader.arrayBlock()) {
+        this->report(_reader.readArrayBlock(entries));
+        return;
+      }
+    } else if constexpr (requires { _reader.arrayBlock(); }) {
+      // Numbers stored as a block can't be decoded into other items
+      if (_reader.arrayBlock()) {
+        this->report(std::errc::invalid_argument);
+        return;
+      }
+    }
+
+    // Allocator-aware items are decoded on this thread, see DeserializerOptions::threads
+    if constexpr (Detail::SplitReader<Reader> &&
+                  std::ranges::random_access_range<decltype(entries)> &&
+                  !std::uses_allocator_v<Record, std::pmr::polymorphic_allocator<>> &&
+                  requires { _reader.arraySize(); }) {
+      const auto size = _reader.arraySize();
+      if (size && this->parallel(*size) && this->processChunks(entries, *size)) {
+        return;
+      }
+    }
+
+    auto it = entries.begin();
+    if (_options.collections == CollectionMode::Replace) {
+      entries.clear();
+      it = entries.begin();
+    }
 
-    using T = typename std::decay<decltype(*entries.begin())>::type;
+    // Overwrite the existing items in place, keeping their buffers
+    while (it != entries.end() && _reader.nextArrayEntry()) {
+      this->processEntry(*it);
+      ++it;
+    }
+    if (it != entries.end()) {
+      entries.erase(it, entries.end());
+      return;
+    }
+
+    if constexpr (requires { _reader.arraySize(); entries.reserve(0); }) {
+      if (const auto size = _reader.arraySize()) {
+        entries.reserve(entries.size() + *size);
+      }
+    }
+    while (_reader.nextArrayEntry()) {
+      if constexpr (Detail::FixedCapacity<std::remove_cvref_t<decltype(entries)>>) {
+        if (entries.size() == entries.capacity()) {
+          this->dropItem<Record>();
+          continue;
+        }
+      }
+      this->processEntry(this->emplaceItem(entries));
+    }
+  }
+
+  // Append a value-initialized item. Allocator-aware items allocate from the options'
+  // resource, unless their collection hands its own allocator down to them.
+  auto& emplaceItem(auto& entries) {
+    using Items = std::remove_cvref_t<decltype(entries)>;
+    using Item = std::ranges::range_value_t<Items>;
+    if constexpr (std::uses_allocator_v<Item, std::pmr::polymorphic_allocator<>> &&
+                  !std::uses_allocator_v<Items, std::pmr::polymorphic_allocator<>>) {
+      return entries.emplace_back(this->makeValue<Item>());
+    } else {
+      return entries.emplace_back();
+    }
+  }
+
+  // Array split into one run of items per thread, each run decoded by a sequential
+  // Deserializer into its slots of the resized collection, the last one on this thread.
+  // Returns false when the collection can't hold the items or the array can't be split.
+  bool processChunks(auto& entries, std::size_t size) {
+    if (_options.collections == CollectionMode::Replace) {
+      entries.clear();
+    }
+    if (!Detail::resizeItems(entries, size)) {
+      return false;
+    }
+    auto readers = _reader.splitArray(_options.threads);
+    if (readers.empty()) {
+      return false;
+    }
+
+    auto options = _options;
+    options.threads = 1;
+    const auto decode = [&options](auto first, Reader reader) {
+      Deserializer part(std::move(reader), options);
+      for (auto it = first; part._reader.nextArrayEntry(); ++it) {
+        part.processEntry(*it);
+      }
+      return part;
+    };
+
+    std::vector<std::future<Deserializer>> parts;
+    parts.reserve(readers.size() - 1);
+    auto first = entries.begin();
+    for (std::size_t index = 0; index + 1 < readers.size(); ++index) {
+      const auto count = readers[index].arraySize().value_or(0);
+      parts.push_back(
+        std::async(std::launch::async, decode, first, std::move(readers[index])));
+      first += static_cast<std::ptrdiff_t>(count);
+    }
+    const auto last = decode(first, std::move(readers.back()));
+
+    for (auto& part : parts) {
+      this->merge(part.get());
+    }
+    this->merge(last);
+    return true;
+  }
+
+  // Errors and stats of a Deserializer decoding part of the input
+  void merge(const Deserializer& part) {
+    this->report(part._error);
+    _stats.unknownEntries += part._stats.unknownEntries;
+  }
+
+  bool parallel(std::size_t size) const {
+    return _options.threads > 1 && size >= _options.parallelThreshold &&
+           _options.resource == std::pmr::get_default_resource();
+  }
+
+  // Process a fixed-size array, decoding over its items in place.
+  // Items missing from the input are reset to a default value.
+  void processEntry(Detail::FixedArray auto& items) {
+    using Item = std::ranges::range_value_t<decltype(items)>;
+    std::fill(this->processSlots(items), items.end(), Item{});
+  }
+
+  // Decode an array over a range of items of a fixed size, dropping the items in excess.
+  // Returns the end of the items decoded.
+  auto processSlots(auto& items) {
+    using Item = std::ranges::range_value_t<decltype(items)>;
+    if constexpr (requires { _reader.readArrayBlock(items); }) {
+      if (_reader.arrayBlock()) {
+        this->report(_reader.readArrayBlock(items));
+        return items.end();
+      }
+    } else if constexpr (requires { _reader.arrayBlock(); }) {
+      // Numbers stored as a block can't be decoded into other items
+      if (_reader.arrayBlock()) {
+        this->report(std::errc::invalid_argument);
+        return items.end();
+      }
+    }
+
+    auto it = items.begin();
     while (_reader.nextArrayEntry()) {
-      T newEntry;
-      this->processEntry(newEntry);
-      entries.push_back(std::move(newEntry));
+      if (it == items.end()) {
+        this->dropItem<Item>();
+        continue;
+      }
+      this->processEntry(*it);
+      ++it;
+    }
+    return it;
+  }
+
+  // Decode an item overflowing its fixed-size collection into a scratch value,
+  // so that the reader stays in sync with the input
+  template<typename Item>
+  void dropItem() {
+    this->report(std::errc::value_too_large);
+    auto item = this->makeValue<Item>();
+    this->processEntry(item);
+  }
+
+  // Value-initialized T, allocator-aware types allocating from the options' resource
+  template<typename T>
+  T makeValue() const {
+    if constexpr (std::uses_allocator_v<T, std::pmr::polymorphic_allocator<>>) {
+      return std::make_obj_using_allocator<T>(
+        std::pmr::polymorphic_allocator<>(_options.resource));
+    } else {
+      return T{};
+    }
+  }
+
+  // Collections of records, the only targets columns are decoded into
+  template<typename T>
+  static constexpr bool ColumnTarget = Detail::Collection<T> && requires(T& items) {
+    items.resize(0);
+    requires Deserializable<std::ranges::range_value_t<T>, Deserializer<Reader>>;
+  };
+
+  // Skip the columns entered by the last entry name when they can't be decoded into T,
+  // reporting the mismatch. Returns whether they were skipped.
+  template<typename T>
+  bool skipColumns() {
+    if constexpr (!ColumnTarget<T> && requires { _reader.columnCount(); }) {
+      if (_reader.columnCount()) {
+        this->report(std::errc::invalid_argument);
+        this->skipSubtree();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Records stored column by column, each column decoded in place into its field of every
+  // record so that reused records keep the buffers of their fields
+  void processColumns(auto& records, std::size_t count) {
+    if (_options.collections == CollectionMode::Replace) {
+      records.clear();
+    }
+    if (!Detail::resizeItems(records, count)) {
+      this->report(std::errc::value_too_large);
+      for (auto [name, valid] = _reader.nextEntryName(); valid;
+           std::tie(name, valid) = _reader.nextEntryName()) {
+        this->skipSubtree();
+      }
+      return;
+    }
+    if (count == 0) {
+      this->deserialize();
+      return;
+    }
+
+    Detail::FieldsProbe probe([this, &records]<typename... Fields>(Fields&... fields) {
+      constexpr auto& table = _nameTable<Fields...>;
+      for (auto [name, valid] = _reader.nextEntryName(); valid;
+           std::tie(name, valid) = _reader.nextEntryName()) {
+        const auto index = table.find(name);
+        if (index == table.npos) {
+          this->skipEntry();
+          continue;
+        }
+        this->visitAt(
+          index,
+          [this, &records](auto& field) {
+            this->processColumn<std::decay_t<decltype(field)>>(records);
+          },
+          std::index_sequence_for<Fields...>{},
+          fields...);
+      }
+    });
+    records.front().deserialize(probe);
+  }
+
+  // Column of Field, decoded over the values of that field in the records
+  template<typename Field>
+  void processColumn(auto& records) {
+    if constexpr (Detail::BorrowedField<Field> && Detail::ColumnField<Field>) {
+      auto values = records | std::views::transform([](auto& record) -> auto& {
+                      return Detail::fieldOf<Field>(record);
+                    });
+      this->processSlots(values);
+    } else {
+      // Either the record's own value is a temporary of its deserialize() call, or the
+      // field is never written as a column
+      this->skipSubtree();
     }
   }
 
   template<typename... Attrs>
   void processAttrs(Attrs&... attrs) {
-    if constexpr (sizeof...(Attrs) > 0) {
+    if constexpr (sizeof...(Attrs) > 0 && Detail::AttrBatchReader<Reader>) {
+      this->processAttrBatch(attrs...);
+    } else if constexpr (sizeof...(Attrs) > 0) {
       this->processAttr(attrs...);
     }
   }
 
+  // Walk the element's attributes once, dispatching each one by name
+  template<typename... Attrs>
+  void processAttrBatch(Attrs&... attrs) {
+    _reader.readAttrs([&](std::string_view name, auto&& parse) {
+      constexpr auto& table = _nameTable<Attrs...>;
+      const auto index = table.find(name);
+      if (index == table.npos) {
+        return;
+      }
+
+      this->visitAt(
+        index,
+        [this, &parse](auto& attr) { this->report(parse(attr.value)); },
+        std::index_sequence_for<Attrs...>{},
+        attrs...);
+    });
+  }
+
   template<StringLiteral Name, typename T, typename... Attrs>
   void processAttr(Attr<Name, T>& attr, Attrs&... attrs) {
-    _reader.attrValue(attr.name, attr.value);
+    this->report(_reader.attrValue(NameTag<Name>{}, attr.value));
     this->processAttrs(attrs...);
   }
 
   // Fallback
   void processEntry(auto& entry) {
-    _reader.value(entry);
+    this->report(_reader.value(entry));
+  }
+
+  // Skip an unknown entry and its whole subtree
+  void skipEntry() {
+    ++_stats.unknownEntries;
+    this->skipSubtree();
+  }
+
+  void skipSubtree() {
+    if constexpr (requires { _reader.skipEntry(); }) {
+      if (!_reader.skipEntry()) {
+        this->report(std::errc::invalid_argument);
+      }
+    } else {
+      // Readers unable to tell nested entries apart have their unknown entries read as leaves
+      this->skipValue();
+    }
+  }
+
+  void skipValue() {
+    std::string value;
+    _reader.value(value);
+  }
+
+  void report(std::errc error) {
+    if (_error == std::errc{}) {
+      _error = error;
+    }
   }
 
  private:
   Reader _reader;
+  DeserializerOptions _options;
+  std::errc _error{};
+  DeserializerStats _stats;
+  bool _started{};
+
+  template<typename... Entries>
+  static constexpr auto _nameTable =
+    Detail::NameTable<sizeof...(Entries)>({ entryName<Entries>()... });
 };
 
-template<typename Reader>
+template<Detail::EntryNameReader Reader>
 Deserializer(Reader) -> Deserializer<Reader>;
 
+template<Detail::EntryNameReader Reader>
+Deserializer(Reader, DeserializerOptions) -> Deserializer<Reader>;
+
 #endif // !CPPDICT_DESERIALIZER
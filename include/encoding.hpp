@@ -0,0 +1,54 @@
+#ifndef CPPDICT_ENCODING_HPP
+#define CPPDICT_ENCODING_HPP
+
+#include <type_traits>
+
+enum class EncodingKind {
+  Raw,      // Values as they are laid out in memory
+  Delta,    // Zigzag varint differences between consecutive integers
+  Packed,   // Offsets from the smallest integer, bit-packed at the width of the largest one
+  Columnar, // User records transposed into one collection per field
+};
+
+// Encoding hint given to makeEntry next to the entry's attributes,
+// e.g. makeEntry<"Ids">(ids, DeltaEncoding{}). Backends without support ignore it.
+template<EncodingKind Kind>
+struct Encoding {
+  static constexpr EncodingKind kind = Kind;
+};
+
+using RawEncoding = Encoding<EncodingKind::Raw>;
+using DeltaEncoding = Encoding<EncodingKind::Delta>;
+using PackedEncoding = Encoding<EncodingKind::Packed>;
+using ColumnarEncoding = Encoding<EncodingKind::Columnar>;
+
+namespace Detail {
+
+  template<typename T>
+  struct IsEncodingType : std::false_type {};
+
+  template<EncodingKind Kind>
+  struct IsEncodingType<Encoding<Kind>> : std::true_type {};
+
+  template<typename T>
+  concept IsEncoding = IsEncodingType<std::remove_cvref_t<T>>::value;
+
+  // First encoding hint among an entry's attributes, RawEncoding if none
+  template<typename... Attrs>
+  struct EncodingOfType {
+    using type = RawEncoding;
+  };
+
+  template<typename Attr, typename... Attrs>
+  struct EncodingOfType<Attr, Attrs...> {
+    using type = std::conditional_t<IsEncoding<Attr>,
+                                    std::remove_cvref_t<Attr>,
+                                    typename EncodingOfType<Attrs...>::type>;
+  };
+
+  template<typename... Attrs>
+  using EncodingOf = typename EncodingOfType<Attrs...>::type;
+
+} // namespace Detail
+
+#endif // !CPPDICT_ENCODING_HPP
@@ -1,8 +1,11 @@
 #ifndef CPPDICT_ENTRY_HPP
 #define CPPDICT_ENTRY_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <tuple>
 #include <type_traits>
@@ -10,7 +13,29 @@
 
 #include "attr.hpp"
 #include "concepts.hpp"
+#include "path.hpp"
 #include "stringLiteral.hpp"
+#include "tracking.hpp"
+
+namespace Detail {
+
+  // Position of the entry or attribute named name in a tuple of them, its size if none
+  template<typename Tuple>
+  struct NameIndex;
+
+  template<typename... Items>
+  struct NameIndex<std::tuple<Items...>> {
+    static constexpr std::size_t find(std::string_view name) {
+      constexpr std::string_view names[] = { std::remove_cvref_t<Items>::name..., {} };
+      std::size_t index = 0;
+      while (index < sizeof...(Items) && names[index] != name) {
+        ++index;
+      }
+      return index;
+    }
+  };
+
+} // namespace Detail
 
 template<StringLiteral EntryName, typename Type, typename... Attributes>
 class Entry {
@@ -28,23 +53,54 @@ class Entry {
 
   template<StringLiteral Path, Detail::Invalid PathParsing>
   constexpr auto& get() {
-    constexpr std::string_view path = Path;
-    constexpr bool attrKey = path.starts_with('@');
-    return this->get<std::bool_constant<attrKey>, Path>();
+    return this->get<std::bool_constant<Detail::PathSplit<Path>::attrKey>, Path>();
+  }
+
+  // Read-only access, leaving Tracked entries unstamped
+  template<StringLiteral Path>
+  constexpr const auto& get() const {
+    using Split = Detail::PathSplit<Path>;
+    static_assert(EntryName == Split::key, "Key not found in tuple");
+    if constexpr (Split::last) {
+      return this->value;
+    } else {
+      return this->find<Split::rest>();
+    }
   }
 
  private:
+  template<StringLiteral, typename, typename...>
+  friend class Entry;
+
+  // Value or attribute at Path below this entry
+  template<StringLiteral Path>
+  constexpr const auto& find() const {
+    using Split = Detail::PathSplit<Path>;
+    if constexpr (Split::attrKey) {
+      using Attrs = decltype(Detail::attrRefs(this->attrs));
+      constexpr auto index = Detail::NameIndex<Attrs>::find(Split::view.substr(1));
+      static_assert(index < std::tuple_size_v<Attrs>, "Attribute key not found in tuple");
+      return std::get<index>(Detail::attrRefs(this->attrs)).value;
+    } else {
+      constexpr auto index = Detail::NameIndex<Type>::find(Split::keyView);
+      static_assert(index < std::tuple_size_v<Type>, "Key not found in tuple");
+      const auto& entry = std::get<index>(this->value);
+      if constexpr (Split::last) {
+        return entry.value;
+      } else {
+        return entry.template find<Split::rest>();
+      }
+    }
+  }
+
   // Parse the next entry name from Path
   template<StringLiteral Path, Detail::Valid PathParsing>
   constexpr auto& get() {
-    constexpr std::string_view view = Path;
-    constexpr auto pos = view.find('/');
-    constexpr auto key = view.substr(0, pos);
-    constexpr auto path = view.substr(pos == view.npos ? view.size() : pos + 1);
-    constexpr bool nameMatch = EntryName == key;
+    using Split = Detail::PathSplit<Path>;
+    constexpr bool nameMatch = EntryName == Split::key;
     return this->get<std::bool_constant<nameMatch>,
-                     std::bool_constant<!path.empty()>,
-                     StringLiteral<path.length()>(path.data())>();
+                     std::bool_constant<!Split::last>,
+                     Split::rest>();
   }
 
   // Matching entry name & non empty Path
@@ -56,22 +112,18 @@ class Entry {
   // Matching entry name & empty Path
   template<Detail::Valid Match, Detail::Invalid PathLength, StringLiteral Path>
   constexpr auto& get() {
+    Detail::touch(this->attrs);
     return this->value;
   }
 
   // Parameter pack lookup
   template<StringLiteral Path, typename... Entries>
   constexpr auto& get(std::tuple<Entries...>& entries) {
-    constexpr std::string_view view = Path;
-    constexpr auto pos = view.find('/');
-    constexpr auto name = view.substr(0, pos);
-    constexpr auto path = view.substr(pos == view.npos ? view.size() : pos + 1);
-
+    using Split = Detail::PathSplit<Path>;
     return std::apply( //
-      [this, &name, &path](auto&... entries) -> auto& {
-        return this->get<StringLiteral<name.length()>(name.data()),
-                         std::bool_constant<!path.empty()>,
-                         StringLiteral<path.length()>(path.data())>(entries...);
+      [this](auto&... entries) -> auto& {
+        return this->get<Split::key, std::bool_constant<!Split::last>, Split::rest>(
+          entries...);
       },
       entries);
   }
@@ -97,7 +149,7 @@ class Entry {
            typename T,
            typename... Attrs,
            typename... Entries>
-  constexpr auto& get(Entry<Key, T, Attrs...>& entry, Entries&... entries) {
+  constexpr auto& get(Entry<Key, T, Attrs...>& entry, Entries&...) {
     return entry.template get<Path, std::false_type>();
   }
 
@@ -108,7 +160,8 @@ class Entry {
            StringLiteral Path,
            typename Entry,
            typename... Entries>
-  constexpr auto& get(Entry& entry, Entries&... entries) {
+  constexpr auto& get(Entry& entry, Entries&...) {
+    Detail::touch(entry.attrs);
     return entry.value;
   }
 
@@ -119,7 +172,7 @@ class Entry {
            StringLiteral Path,
            typename Entry,
            typename... Entries>
-  constexpr auto& get(Entry& entry, Entries&... entries) {
+  constexpr auto& get(Entry&, Entries&... entries) {
     return this->get<Key, PathLength, Path>(entries...);
   }
 
@@ -135,11 +188,12 @@ class Entry {
     constexpr std::string_view path = Path;
     constexpr auto attrKey = path.substr(1); // Skip the @ prefix
     constexpr auto attrKeyLiteral = StringLiteral<attrKey.length()>(attrKey.data());
+    Detail::touch(this->attrs);
     return std::apply(
       [this, &attrKeyLiteral](auto&... attrs) -> auto& {
         return this->getAttr<attrKeyLiteral>(attrs...);
       },
-      this->attrs);
+      Detail::attrRefs(this->attrs));
   }
 
   template<StringLiteral AttrKey, StringLiteral Name, typename T, typename... Attrs>
@@ -149,12 +203,12 @@ class Entry {
   }
 
   template<Detail::Valid NameMatch, StringLiteral AttrKey, typename Attr, typename... Attrs>
-  constexpr auto& getAttr(Attr& attr, Attrs&... attrs) {
+  constexpr auto& getAttr(Attr& attr, Attrs&...) {
     return attr.value;
   }
 
   template<Detail::Invalid NameMatch, StringLiteral AttrKey, typename Attr, typename... Attrs>
-  constexpr auto& getAttr(Attr& attr, Attrs&... attrs) {
+  constexpr auto& getAttr(Attr&, Attrs&... attrs) {
     return this->getAttr<AttrKey>(attrs...);
   }
 
@@ -182,14 +236,52 @@ class Entry {
   std::tuple<Attributes...> attrs;
 };
 
-template<StringLiteral Name, typename Type, typename... Attrs>
-constexpr auto makeEntry(const Type& type, Attrs&&... attrs) {
-  return Entry<Name, Type, Attrs...>(type, std::forward<Attrs>(attrs)...);
-}
+namespace Detail {
+
+  // Type an entry stores a makeEntry argument as, C strings being owned as std::string
+  template<typename T>
+  using EntryValue = std::conditional_t<std::is_convertible_v<std::decay_t<T>, const char*>,
+                                        std::string,
+                                        std::decay_t<T>>;
+
+  // Value held by an entry, through the std::reference_wrapper of borrowing entries
+  template<typename T>
+  constexpr auto& unwrapRef(T& value) {
+    if constexpr (std::is_same_v<std::unwrap_reference_t<std::remove_const_t<T>>,
+                                 std::remove_const_t<T>>) {
+      return value;
+    } else {
+      return value.get();
+    }
+  }
 
-template<StringLiteral Name, typename... Attrs>
-constexpr auto makeEntry(const char* str, Attrs&&... attrs) {
-  return Entry<Name, std::string, Attrs...>(std::string(str), std::forward<Attrs>(attrs)...);
+  // Values other than entries, such as user classes, are not tracked
+  constexpr bool changedSince(const auto&, std::uint64_t) {
+    return false;
+  }
+
+  // Whether an entry, or any entry nested in its tuple, was stamped after version since
+  template<StringLiteral Name, typename T, typename... Attrs>
+  bool changedSince(const Entry<Name, T, Attrs...>& entry, std::uint64_t since) {
+    if (touchedSince(entry.attrs, since)) {
+      return true;
+    }
+    if constexpr (EntryTuple<std::unwrap_reference_t<T>>) {
+      return std::apply(
+        [since](const auto&... entries) { return (changedSince(entries, since) || ...); },
+        unwrapRef(entry.value));
+    } else {
+      return false;
+    }
+  }
+
+} // namespace Detail
+
+// Entries move rvalues in and copy lvalues, std::cref(value) borrows the value instead
+template<StringLiteral Name, typename Type, typename... Attrs>
+constexpr auto makeEntry(Type&& value, Attrs&&... attrs) {
+  return Entry<Name, Detail::EntryValue<Type>, Attrs...>(std::forward<Type>(value),
+                                                         std::forward<Attrs>(attrs)...);
 }
 
 #endif // !CPPDICT_ENTRY_HPP
@@ -0,0 +1,292 @@
+#ifndef CPPDICT_FIXED_HPP
+#define CPPDICT_FIXED_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "concepts.hpp"
+
+// Vector storing up to N items inline, it never allocates.
+// Growing it past its capacity throws std::length_error, the Deserializer
+// reports std::errc::value_too_large instead of adding items to a full vector.
+template<typename T, std::size_t N>
+class StaticVector {
+  static_assert(N > 0, "StaticVector needs a capacity");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  StaticVector() = default;
+
+  StaticVector(std::initializer_list<T> items) {
+    if (items.size() > N) {
+      throw std::length_error("StaticVector: too many items");
+    }
+    for (const auto& item : items) {
+      this->emplace_back(item);
+    }
+  }
+
+  StaticVector(const StaticVector& other) {
+    for (const auto& item : other) {
+      this->emplace_back(item);
+    }
+  }
+
+  StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    for (auto& item : other) {
+      this->emplace_back(std::move(item));
+    }
+    other.clear();
+  }
+
+  StaticVector& operator=(const StaticVector& other) {
+    if (this != &other) {
+      this->clear();
+      for (const auto& item : other) {
+        this->emplace_back(item);
+      }
+    }
+    return *this;
+  }
+
+  StaticVector& operator=(StaticVector&& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      this->clear();
+      for (auto& item : other) {
+        this->emplace_back(std::move(item));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+
+  ~StaticVector() {
+    this->clear();
+  }
+
+  template<typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (this->full()) {
+      throw std::length_error("StaticVector: capacity exceeded");
+    }
+    auto* item = std::construct_at(this->data() + _size, std::forward<Args>(args)...);
+    ++_size;
+    return *item;
+  }
+
+  void push_back(const T& item) {
+    this->emplace_back(item);
+  }
+
+  void push_back(T&& item) {
+    this->emplace_back(std::move(item));
+  }
+
+  void pop_back() {
+    std::destroy_at(this->data() + --_size);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    const auto begin = this->begin();
+    const auto pos = begin + (first - begin);
+    const auto end = std::move(begin + (last - begin), this->end(), pos);
+    std::destroy(end, this->end());
+    _size = static_cast<size_type>(end - begin);
+    return pos;
+  }
+
+  void resize(size_type count) {
+    if (count > N) {
+      throw std::length_error("StaticVector: capacity exceeded");
+    }
+    while (_size > count) {
+      this->pop_back();
+    }
+    while (_size < count) {
+      this->emplace_back();
+    }
+  }
+
+  void clear() {
+    std::destroy(this->begin(), this->end());
+    _size = 0;
+  }
+
+  T* data() {
+    return std::launder(reinterpret_cast<T*>(_storage));
+  }
+
+  const T* data() const {
+    return std::launder(reinterpret_cast<const T*>(_storage));
+  }
+
+  iterator begin() {
+    return this->data();
+  }
+
+  iterator end() {
+    return this->data() + _size;
+  }
+
+  const_iterator begin() const {
+    return this->data();
+  }
+
+  const_iterator end() const {
+    return this->data() + _size;
+  }
+
+  T& operator[](size_type index) {
+    return this->data()[index];
+  }
+
+  const T& operator[](size_type index) const {
+    return this->data()[index];
+  }
+
+  T& front() {
+    return *this->data();
+  }
+
+  const T& front() const {
+    return *this->data();
+  }
+
+  T& back() {
+    return this->data()[_size - 1];
+  }
+
+  const T& back() const {
+    return this->data()[_size - 1];
+  }
+
+  size_type size() const {
+    return _size;
+  }
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+  bool full() const {
+    return _size == N;
+  }
+
+  static constexpr size_type capacity() {
+    return N;
+  }
+
+  static constexpr size_type max_size() {
+    return N;
+  }
+
+  friend bool operator==(const StaticVector& lhs, const StaticVector& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+ private:
+  alignas(T) std::byte _storage[N * sizeof(T)];
+  size_type _size{};
+};
+
+// String of up to N chars stored inline, null-terminated.
+// Assigning a longer string fails and leaves the value unchanged.
+template<std::size_t N>
+class FixedString {
+ public:
+  FixedString() = default;
+
+  // The string must fit, it is truncated to N chars otherwise
+  FixedString(std::string_view str) {
+    (void)this->assign(str.substr(0, N));
+  }
+
+  [[nodiscard]] bool assign(std::string_view str) {
+    if (str.size() > N) {
+      return false;
+    }
+    std::copy(str.begin(), str.end(), _data.begin());
+    _data[str.size()] = '\0';
+    _size = str.size();
+    return true;
+  }
+
+  operator std::string_view() const {
+    return { _data.data(), _size };
+  }
+
+  const char* data() const {
+    return _data.data();
+  }
+
+  const char* c_str() const {
+    return _data.data();
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+  static constexpr std::size_t capacity() {
+    return N;
+  }
+
+  friend bool operator==(const FixedString& lhs, const FixedString& rhs) {
+    return std::string_view(lhs) == std::string_view(rhs);
+  }
+
+  friend bool operator==(const FixedString& lhs, std::string_view rhs) {
+    return std::string_view(lhs) == rhs;
+  }
+
+ private:
+  std::array<char, N + 1> _data{};
+  std::size_t _size{};
+};
+
+namespace Detail {
+
+  // Resize a collection to count items, failing when count exceeds its fixed capacity.
+  // Arrays keep their size, their items past count are reset to a default value.
+  template<typename T>
+  requires FixedArray<T> || requires(T& items) { items.resize(std::size_t{}); }
+  bool resizeItems(T& items, std::size_t count) {
+    if constexpr (FixedArray<T>) {
+      if (count > std::tuple_size_v<T>) {
+        return false;
+      }
+      std::fill(items.begin() + count, items.end(), std::ranges::range_value_t<T>{});
+    } else {
+      if constexpr (FixedCapacity<T>) {
+        if (count > T::capacity()) {
+          return false;
+        }
+      }
+      items.resize(count);
+    }
+    return true;
+  }
+
+} // namespace Detail
+
+#endif // !CPPDICT_FIXED_HPP
@@ -0,0 +1,175 @@
+#ifndef CPPDICT_LAZY_HPP
+#define CPPDICT_LAZY_HPP
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "deserializer.hpp"
+#include "path.hpp"
+#include "stringLiteral.hpp"
+
+// Tree decoded on demand from an indexed buffer, such as a BinaryIndex.
+// An entry is decoded the first time it, or one of its descendants, is reached
+// through get<Path>(), entries missing from the buffer keep their initial value.
+// Entries already decoded keep their value, writes included, when an ancestor is decoded.
+// Each Path is looked up in the index on its first access only.
+template<typename Tree, typename Index>
+class LazyTree {
+ public:
+  LazyTree(Tree tree, const Index& index, DeserializerOptions options = {})
+    : _tree(std::move(tree))
+    , _index(&index)
+    , _options(options)
+    , _decoded(index.size()) {}
+
+  template<StringLiteral Path>
+  auto& get() {
+    const auto slot = pathSlot<Path>();
+    if (slot >= _resolved.size()) {
+      _resolved.resize(slot + 1);
+    }
+    if (!_resolved[slot]) {
+      this->resolve<Path>();
+      _resolved[slot] = true;
+    }
+    return _tree.template get<Path>();
+  }
+
+  // First error met while decoding the accessed entries, std::errc{} if none
+  std::errc error() const {
+    return _error;
+  }
+
+ private:
+  // Non-owning reference to a callable outliving it
+  class Callback {
+   public:
+    template<std::invocable F>
+    requires(!std::same_as<F, Callback>) explicit Callback(F& function)
+      : _function(&function)
+      , _call([](void* callable) { (*static_cast<F*>(callable))(); }) {}
+
+    void operator()() const {
+      _call(_function);
+    }
+
+   private:
+    void* _function;
+    void (*_call)(void*);
+  };
+
+  using Keeper = void (*)(LazyTree&, Callback);
+
+  // Index of Path among the paths reached through any LazyTree of this type
+  template<StringLiteral Path>
+  static std::size_t pathSlot() {
+    static const std::size_t slot = _pathCount++;
+    return slot;
+  }
+
+  // Decode the entry at Path unless the buffer lacks it or it is decoded already
+  template<StringLiteral Path>
+  void resolve() {
+    using Split = Detail::AttrPathSplit<Path>;
+    const auto node = _index->find(Split::entry);
+    if (node == Index::npos) {
+      return;
+    }
+
+    // Attributes are kept apart from their entry's value, which doesn't hold them
+    if constexpr (Split::attr) {
+      if (!this->attrDecoded(node, Split::attrView)) {
+        if (!this->decoded(node)) {
+          this->decode<Path>(node);
+        }
+        _decodedAttrs.emplace_back(node, Split::attrView);
+        _kept.emplace_back(node, &LazyTree::keep<Path>);
+      }
+    } else if (!this->decoded(node)) {
+      this->decode<Path>(node);
+      _decoded[node] = true;
+      _kept.emplace_back(node, &LazyTree::keep<Path>);
+    }
+  }
+
+  template<StringLiteral Path>
+  void decode(std::size_t node) {
+    auto run = [this, node] {
+      Deserializer deserializer(_index->reader(node), _options);
+      const bool found = deserializer.template deserializeAt<Path>(_tree);
+      this->report(found ? deserializer.error() : std::errc::invalid_argument);
+    };
+    this->decodeKeeping(0, node, Callback(run));
+  }
+
+  // Run decode with the values decoded earlier within node's subtree moved out of the way
+  void decodeKeeping(std::size_t first, std::size_t node, Callback decode) {
+    for (auto i = first; i < _kept.size(); ++i) {
+      if (this->within(_kept[i].first, node)) {
+        auto rest = [this, i, node, decode] { this->decodeKeeping(i + 1, node, decode); };
+        _kept[i].second(*this, Callback(rest));
+        return;
+      }
+    }
+    decode();
+  }
+
+  template<StringLiteral Path>
+  static void keep(LazyTree& lazy, Callback decode) {
+    auto value = std::move(lazy._tree.template get<Path>());
+    decode();
+    lazy._tree.template get<Path>() = std::move(value);
+  }
+
+  bool within(std::size_t node, std::size_t ancestor) const {
+    for (; node != Index::npos; node = _index->parent(node)) {
+      if (node == ancestor) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool decoded(std::size_t node) const {
+    for (; node != Index::npos; node = _index->parent(node)) {
+      if (_decoded[node]) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool attrDecoded(std::size_t node, std::string_view name) const {
+    for (const auto& [attrNode, attrName] : _decodedAttrs) {
+      if (attrNode == node && attrName == name) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void report(std::errc error) {
+    if (_error == std::errc{}) {
+      _error = error;
+    }
+  }
+
+ private:
+  Tree _tree;
+  const Index* _index;
+  DeserializerOptions _options;
+  std::vector<bool> _decoded;
+  std::vector<std::pair<std::size_t, std::string_view>> _decodedAttrs;
+  std::vector<std::pair<std::size_t, Keeper>> _kept;
+  std::vector<bool> _resolved; // By path slot
+  std::errc _error{};
+
+  static inline std::atomic<std::size_t> _pathCount{};
+};
+
+#endif // !CPPDICT_LAZY_HPP
@@ -0,0 +1,152 @@
+#ifndef CPPDICT_NAME_TABLE_HPP
+#define CPPDICT_NAME_TABLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Detail {
+
+  constexpr std::uint64_t hashName(std::string_view name) {
+    std::uint64_t hash = 0xcbf29ce484222325ull; // FNV-1a
+    for (const char c : name) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    return hash;
+  }
+
+  constexpr std::uint64_t mixHash(std::uint64_t hash) {
+    hash ^= hash >> 33; // murmur3 finalizer
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  // Compile-time perfect hash over a set of entry names (hash and displace).
+  // A lookup costs one string hash, two integer mixes and one string compare.
+  // Should a bucket find no seed within MaxSeeds, names are binary searched instead.
+  template<std::size_t N>
+  class NameTable {
+   public:
+    static constexpr std::size_t Size = std::bit_ceil(std::max<std::size_t>(2 * N, 1));
+    static constexpr std::size_t npos = N;
+    static constexpr std::uint64_t MaxSeeds = 4096;
+
+    constexpr explicit NameTable(std::array<std::string_view, N> names)
+      : _names(names) {
+      std::array<std::uint64_t, N> hashes{};
+      std::array<bool, N> unique{};
+      std::array<std::size_t, Size> bucketSizes{};
+      for (std::size_t i = 0; i < N; ++i) {
+        hashes[i] = mixHash(hashName(names[i]));
+        // Duplicated names resolve to their first occurrence
+        unique[i] = std::find(names.begin(), names.begin() + i, names[i]) == names.begin() + i;
+        bucketSizes[this->bucket(hashes[i])] += unique[i];
+      }
+
+      std::array<std::size_t, Size> buckets{};
+      for (std::size_t i = 0; i < Size; ++i) {
+        buckets[i] = i;
+      }
+      std::sort(buckets.begin(), buckets.end(), [&](std::size_t lhs, std::size_t rhs) {
+        return bucketSizes[lhs] > bucketSizes[rhs];
+      });
+
+      _slots.fill(npos);
+      for (const auto bucket : buckets) {
+        if (bucketSizes[bucket] == 0) {
+          break;
+        }
+        std::uint64_t seed = 1;
+        while (seed <= MaxSeeds && !this->place(bucket, seed, hashes, unique)) {
+          ++seed;
+        }
+        if (seed > MaxSeeds) {
+          this->sortNames();
+          return;
+        }
+        _seeds[bucket] = seed;
+      }
+    }
+
+    // Index of name in the table, npos when unknown
+    constexpr std::size_t find(std::string_view name) const {
+      if constexpr (N == 0) {
+        return npos;
+      } else {
+        if (_sorted) {
+          const auto less = [this](std::size_t index, std::string_view key) {
+            return _names[index] < key;
+          };
+          const auto it = std::lower_bound(_order.begin(), _order.end(), name, less);
+          return it != _order.end() && _names[*it] == name ? *it : npos;
+        }
+        const auto hash = mixHash(hashName(name));
+        const auto index = _slots[this->slot(hash, _seeds[this->bucket(hash)])];
+        return index != npos && _names[index] == name ? index : npos;
+      }
+    }
+
+    constexpr std::size_t size() const {
+      return N;
+    }
+
+   private:
+    // The raw FNV-1a hash of names differing in their last chars only differs in its low
+    // and top bits, buckets and slots are taken from mixed hashes
+    static constexpr std::size_t bucket(std::uint64_t hash) {
+      return (hash >> 32) & (Size - 1);
+    }
+
+    static constexpr std::size_t slot(std::uint64_t hash, std::uint64_t seed) {
+      return mixHash(hash + seed * 0x9e3779b97f4a7c15ull) & (Size - 1);
+    }
+
+    // Fallback ordering names, equal ones by index so that the first occurrence is found
+    constexpr void sortNames() {
+      for (std::size_t i = 0; i < N; ++i) {
+        _order[i] = i;
+      }
+      std::sort(_order.begin(), _order.end(), [this](std::size_t lhs, std::size_t rhs) {
+        return _names[lhs] < _names[rhs] || (_names[lhs] == _names[rhs] && lhs < rhs);
+      });
+      _sorted = true;
+    }
+
+    constexpr bool place(std::size_t bucket,
+                         std::uint64_t seed,
+                         const std::array<std::uint64_t, N>& hashes,
+                         const std::array<bool, N>& unique) {
+      std::array<std::size_t, N> placed{};
+      std::size_t count = 0;
+      for (std::size_t i = 0; i < N; ++i) {
+        if (!unique[i] || this->bucket(hashes[i]) != bucket) {
+          continue;
+        }
+        const auto slot = this->slot(hashes[i], seed);
+        if (_slots[slot] != npos) {
+          for (std::size_t j = 0; j < count; ++j) {
+            _slots[placed[j]] = npos;
+          }
+          return false;
+        }
+        _slots[slot] = i;
+        placed[count++] = slot;
+      }
+      return true;
+    }
+
+   private:
+    std::array<std::string_view, N> _names{};
+    std::array<std::uint64_t, Size> _seeds{};
+    std::array<std::size_t, Size> _slots{};
+    std::array<std::size_t, N> _order{};
+    bool _sorted{};
+  };
+
+} // namespace Detail
+
+#endif // !CPPDICT_NAME_TABLE_HPP
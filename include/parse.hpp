@@ -0,0 +1,70 @@
+#ifndef CPPDICT_PARSE_HPP
+#define CPPDICT_PARSE_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "concepts.hpp"
+#include "fixed.hpp"
+
+namespace Detail {
+
+  // Parse text read by a backend straight into its target, without temporaries or exceptions
+  template<Number T>
+  std::errc parseValue(std::string_view input, T& value) {
+    if (!input.empty() && input.front() == '+') {
+      input.remove_prefix(1);
+    }
+
+    T parsed{};
+    const auto* const last = input.data() + input.size();
+    const auto [end, error] = std::from_chars(input.data(), last, parsed);
+    if (error != std::errc{}) {
+      return error;
+    }
+    if (end != last) {
+      return std::errc::invalid_argument;
+    }
+
+    value = parsed;
+    return {};
+  }
+
+  inline std::errc parseValue(std::string_view input, bool& value) {
+    const auto equals = [input](std::string_view expected) {
+      return std::ranges::equal(input, expected, [](char lhs, char rhs) {
+        return (lhs | 0x20) == rhs;
+      });
+    };
+
+    if (equals("true")) {
+      value = true;
+    } else if (equals("false")) {
+      value = false;
+    } else {
+      return std::errc::invalid_argument;
+    }
+    return {};
+  }
+
+  // Strings of any allocator, std::pmr::string keeping its memory resource
+  template<typename Allocator>
+  std::errc parseValue(std::string_view input,
+                       std::basic_string<char, std::char_traits<char>, Allocator>& value) {
+    value.assign(input);
+    return {};
+  }
+
+  template<std::size_t N>
+  std::errc parseValue(std::string_view input, FixedString<N>& value) {
+    return value.assign(input) ? std::errc{} : std::errc::value_too_large;
+  }
+
+} // namespace Detail
+
+#endif // !CPPDICT_PARSE_HPP
@@ -0,0 +1,38 @@
+#ifndef CPPDICT_PATH_HPP
+#define CPPDICT_PATH_HPP
+
+#include <string_view>
+
+#include "stringLiteral.hpp"
+
+namespace Detail {
+
+  // Split a compile-time "Key/Rest/Of/Path" on its first separator
+  template<StringLiteral Path>
+  struct PathSplit {
+    static constexpr std::string_view view = Path;
+    static constexpr auto pos = view.find('/');
+    static constexpr auto keyView = view.substr(0, pos);
+    static constexpr auto restView = view.substr(pos == view.npos ? view.size() : pos + 1);
+
+    static constexpr auto key = StringLiteral<keyView.length()>(keyView.data());
+    static constexpr auto rest = StringLiteral<restView.length()>(restView.data());
+    static constexpr bool last = restView.empty();
+    static constexpr bool attrKey = view.starts_with('@');
+  };
+
+  // Entry an attribute path refers to, "Root/Int/@Enabled" -> "Root/Int" and "Enabled"
+  template<StringLiteral Path>
+  struct AttrPathSplit {
+    static constexpr std::string_view view = Path;
+    static constexpr auto pos = view.rfind("/@");
+    static constexpr auto entryView = view.substr(0, pos);
+    static constexpr auto attrView = view.substr(pos == view.npos ? view.size() : pos + 2);
+
+    static constexpr auto entry = StringLiteral<entryView.length()>(entryView.data());
+    static constexpr bool attr = pos != view.npos;
+  };
+
+} // namespace Detail
+
+#endif // !CPPDICT_PATH_HPP
@@ -0,0 +1,105 @@
+#ifndef CPPDICT_SCHEMA_HPP
+#define CPPDICT_SCHEMA_HPP
+
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "attr.hpp"
+#include "concepts.hpp"
+#include "entry.hpp"
+#include "nameTable.hpp"
+#include "versioning.hpp"
+
+// Compile-time fingerprint of the entries of a tree: their names, order, value types and
+// attributes, nested tuples included. User classes only contribute their EntryName, their
+// fields are declared at runtime by serialize() and deserialize().
+// Deprecated entries are left out, as the latest schema version doesn't write them.
+namespace Detail {
+
+  constexpr std::uint64_t combineSchema(std::uint64_t seed, std::uint64_t value) {
+    return mixHash(seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+  }
+
+  template<typename T>
+  struct SchemaOf;
+
+  // Entries dropped by the latest schema version, see Deprecated
+  template<typename T>
+  constexpr bool Retired = false;
+
+  template<StringLiteral Name, typename T, typename... Attrs>
+  constexpr bool Retired<Entry<Name, T, Attrs...>> = (IsDeprecated<Attrs> || ...);
+
+  template<typename... Entries>
+  constexpr std::uint64_t schemaHash() {
+    std::uint64_t hash = (std::uint64_t{ !Retired<std::remove_cvref_t<Entries>> } + ... + 0);
+    ((hash = Retired<std::remove_cvref_t<Entries>>
+        ? hash
+        : combineSchema(hash, SchemaOf<std::remove_cvref_t<Entries>>::value)),
+     ...);
+    return hash;
+  }
+
+  template<typename T>
+  constexpr std::uint64_t valueSchema() {
+    using Value = std::remove_cvref_t<std::unwrap_reference_t<T>>;
+    if constexpr (std::same_as<Value, bool>) {
+      return hashName("bool");
+    } else if constexpr (std::integral<Value>) {
+      return combineSchema(hashName(std::signed_integral<Value> ? "int" : "uint"),
+                           sizeof(Value));
+    } else if constexpr (std::floating_point<Value>) {
+      return combineSchema(hashName("float"), sizeof(Value));
+    } else if constexpr (StringLike<Value>) {
+      return hashName("string");
+    } else if constexpr (requires { std::string_view(Value::EntryName); }) {
+      return combineSchema(hashName("object"), hashName(Value::EntryName));
+    } else if constexpr (SerializableRange<Value>) {
+      using Item = std::ranges::range_value_t<Value>;
+      return combineSchema(hashName("array"), valueSchema<Item>());
+    } else {
+      return hashName("unknown");
+    }
+  }
+
+  template<typename T>
+  struct SchemaOf {
+    static constexpr std::uint64_t value = valueSchema<T>();
+  };
+
+  template<typename... Entries>
+  struct SchemaOf<std::tuple<Entries...>> {
+    static constexpr std::uint64_t value =
+      combineSchema(hashName("tuple"), schemaHash<Entries...>());
+  };
+
+  template<StringLiteral Name, typename T>
+  struct SchemaOf<Attr<Name, T>> {
+    static constexpr std::uint64_t value = combineSchema(hashName(Name), valueSchema<T>());
+  };
+
+  // Attributes, leaving out tags such as encodings which don't change the entries' order
+  template<typename... Attrs>
+  constexpr std::uint64_t attrsSchema() {
+    std::uint64_t hash = 0;
+    ((hash = IsAttr<Attrs> ? combineSchema(hash, SchemaOf<std::remove_cvref_t<Attrs>>::value)
+                           : hash),
+     ...);
+    return hash;
+  }
+
+  template<StringLiteral Name, typename T, typename... Attrs>
+  struct SchemaOf<Entry<Name, T, Attrs...>> {
+    using Value = std::remove_cvref_t<std::unwrap_reference_t<T>>;
+    static constexpr std::uint64_t value = combineSchema(
+      combineSchema(hashName(Name), SchemaOf<Value>::value), attrsSchema<Attrs...>());
+  };
+
+} // namespace Detail
+
+#endif // !CPPDICT_SCHEMA_HPP
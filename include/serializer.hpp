@@ -1,20 +1,47 @@
 #ifndef CPPDICT_SERIALIZER_HPP
 #define CPPDICT_SERIALIZER_HPP
 
+#include <algorithm>
 #include <bits/utility.h>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "columns.hpp"
 #include "concepts.hpp"
+#include "encoding.hpp"
 #include "entry.hpp"
+#include "schema.hpp"
+#include "stringLiteral.hpp"
+#include "versioning.hpp"
+
+struct SerializerOptions {
+  // Threads writing large subtrees concurrently, this one included, with Writers satisfying
+  // Detail::SpliceWriter. Subtrees are written into forked writers then spliced back in order,
+  // giving the same output as a sequential run. Nested subtrees share these threads.
+  std::size_t threads{ 1 };
+  // Item count from which a collection is split across threads and a tuple child gets a task
+  std::size_t parallelThreshold{ 4096 };
+  // Schema version written, entries tagged Since a later one or Deprecated by this one are
+  // left out for readers still on it
+  std::uint32_t version{ Detail::LatestVersion };
+};
 
 template<typename Writer>
 class Serializer {
  public:
-  Serializer(Writer writer)
-    : _writer(std::move(writer)) {}
+  Serializer(Writer writer, SerializerOptions options = {})
+    : _writer(std::move(writer))
+    , _options(options) {}
+
   template<typename Entry, typename... Entries>
   void serialize(const Entry& entry, const Entries&... entries) {
     this->serializeEntry(entry);
@@ -23,54 +50,302 @@ class Serializer {
     }
   }
 
+  // Write entries after a fingerprint of their schema, names, types and order of the entries
+  // and their nested tuples. Deserializers of the same schema then decode them by position.
+  // Older versions written may leave entries out, their fingerprint never matches.
+  template<typename... Entries>
+  void serializeWithSchema(const Entries&... entries) {
+    if constexpr (requires { _writer.writeSchema(std::uint64_t{}); }) {
+      auto schema = Detail::schemaHash<Entries...>();
+      if (_options.version != Detail::LatestVersion) {
+        schema = Detail::combineSchema(schema, _options.version);
+      }
+      _writer.writeSchema(schema);
+    }
+    this->serialize(entries...);
+  }
+
+  // Write only what changed in entry after version since (see Tracked): tracked entries
+  // stamped since then are written whole, within the tuples leading to them. Deserializing
+  // the output with DeserializerOptions::patch applies it as a patch, entries missing from
+  // the input being left as is.
+  template<typename Entry>
+  void serializeDelta(const Entry& entry, std::uint64_t since) {
+    if (Detail::changedSince(entry, since)) {
+      this->serializeChanges(entry, since);
+    }
+  }
+
  private:
+  template<StringLiteral Name, typename T, typename... Attrs>
+  void serializeChanges(const Entry<Name, T, Attrs...>& entry, std::uint64_t since) {
+    if (!Detail::entryInVersion(entry.attrs, _options.version)) {
+      return;
+    }
+    const auto& value = Detail::unwrapRef(entry.value);
+    if constexpr (Detail::EntryTuple<decltype(value)>) {
+      if (!Detail::touchedSince(entry.attrs, since)) {
+        _writer.writeObjStartElement(NameTag<Name>{});
+        std::apply(
+          [this, since](const auto&... entries) {
+            (this->serializeDelta(entries, since), ...);
+          },
+          value);
+        _writer.writeObjEndElement();
+        return;
+      }
+    }
+    this->serializeEntry(entry);
+  }
+
+  // Entry holding its value, or borrowing it through std::cref
+  template<StringLiteral Name, typename T, typename... Attrs>
+  void serializeEntry(const Entry<Name, T, Attrs...>& entry) {
+    if (!Detail::entryInVersion(entry.attrs, _options.version)) {
+      return;
+    }
+    this->serializeEntry(NameTag<Name>{}, Detail::unwrapRef(entry.value), entry.attrs);
+  }
+
   // Tuple entry
-  template<StringLiteral Name, typename... Entries, typename... Attrs>
-  void serializeEntry(const Entry<Name, std::tuple<Entries...>, Attrs...>& entry) {
-    _writer.writeObjStartElement(entry.name);
-    if constexpr (sizeof...(Attrs) > 0) {
-      this->serializeAttributes(entry.attrs);
+  template<typename Name, typename... Entries, typename... Attrs>
+  void serializeEntry(Name name,
+                      const std::tuple<Entries...>& value,
+                      const std::tuple<Attrs...>& attrs) {
+    _writer.writeObjStartElement(name);
+    if constexpr (Detail::hasAttrs<Attrs...>) {
+      this->serializeAttributes(Detail::attrRefs(attrs));
     }
-    std::apply([this](const auto&... entries) { this->serialize(entries...); }, entry.value);
+    this->serializeChildren(value);
     _writer.writeObjEndElement();
   }
 
+  // Tuple children, written concurrently when several of them are large
+  template<typename... Entries>
+  void serializeChildren(const std::tuple<Entries...>& children) {
+    if constexpr (Detail::SpliceWriter<Writer> && sizeof...(Entries) > 1) {
+      const auto tasks = std::apply(
+        [this](const auto&... entries) {
+          return (std::size_t{ this->parallel(weight(entries)) } + ...);
+        },
+        children);
+      if (tasks > 1) {
+        std::apply([this](const auto&... entries) { this->serializeTasks(entries...); },
+                   children);
+        return;
+      }
+    }
+    std::apply([this](const auto&... entries) { this->serialize(entries...); }, children);
+  }
+
   // Collection entry
-  template<StringLiteral Name, Detail::Collection Range, typename... Attrs>
-  void serializeEntry(const Entry<Name, Range, Attrs...>& entry) {
-    _writer.writeArrayStartElement(entry.name);
-    for (const auto& entry : entry.value) {
-      this->serializeEntry(entry);
+  template<typename Name, Detail::SerializableRange Range, typename... Attrs>
+  void serializeEntry(Name name, const Range& value, const std::tuple<Attrs...>&) {
+    using Encoding = Detail::EncodingOf<Attrs...>;
+    using Block = std::span<const std::ranges::range_value_t<Range>>;
+    if constexpr (Detail::NumberBlock<Range> && requires(Writer& writer) {
+                    writer.writeArrayBlock(name, Block(value), Encoding{});
+                  }) {
+      _writer.writeArrayBlock(name, Block(value), Encoding{});
+      return;
+    } else if constexpr (Encoding::kind == EncodingKind::Columnar &&
+                         Serializable<std::ranges::range_value_t<Range>, Serializer<Writer>> &&
+                         std::ranges::sized_range<const Range> &&
+                         requires(Writer& writer) {
+                           writer.writeColumnsStartElement(name, std::size_t{});
+                         }) {
+      this->serializeColumns(name, value);
+      return;
+    }
+
+    this->serializeArray(name, value);
+  }
+
+  template<typename Name, typename Range>
+  void serializeArray(Name name, const Range& value) {
+    _writer.writeArrayStartElement(name);
+    if constexpr (std::ranges::input_range<const Range>) {
+      this->serializeItems(value);
+    } else {
+      auto items = value;
+      this->serializeItems(items);
     }
     _writer.writeArrayEndElement();
   }
 
-  // Simple entry
+  // Items streamed from the range, without materializing it
+  template<typename Range>
+  void serializeItems(Range& items) {
+    if constexpr (std::ranges::sized_range<Range> &&
+                  requires(Writer& writer) { writer.writeArraySize(std::size_t{}); }) {
+      _writer.writeArraySize(std::ranges::size(items));
+    }
+    if constexpr (Detail::SpliceWriter<Writer> && std::ranges::random_access_range<Range> &&
+                  std::ranges::sized_range<Range>) {
+      if (this->parallel(std::ranges::size(items))) {
+        this->serializeChunks(items);
+        return;
+      }
+    }
+    for (auto&& item : items) {
+      this->serializeEntry(item);
+    }
+  }
+
+  // Items split into one contiguous chunk per thread, the first chunk written on this thread.
+  // Each chunk gets its share of the threads, for the large collections it holds.
+  template<typename Range>
+  void serializeChunks(Range& items) {
+    const auto size = std::ranges::size(items);
+    const auto threads = _options.threads;
+    const auto chunks = std::min(threads, static_cast<std::size_t>(size));
+    const auto chunk = [&items, size, chunks](std::size_t index) {
+      return std::ranges::begin(items) + size * index / chunks;
+    };
+
+    std::vector<std::future<Writer>> parts;
+    parts.reserve(chunks - 1);
+    for (std::size_t index = 1; index < chunks; ++index) {
+      const auto first = chunk(index);
+      const auto last = chunk(index + 1);
+      parts.push_back(this->launch(share(threads, chunks, index), [first, last](auto& part) {
+        for (auto it = first; it != last; ++it) {
+          part.serializeEntry(*it);
+        }
+      }));
+    }
+    _options.threads = share(threads, chunks, 0);
+    for (auto it = chunk(0), last = chunk(1); it != last; ++it) {
+      this->serializeEntry(*it);
+    }
+    _options.threads = threads;
+    for (auto& part : parts) {
+      _writer.splice(part.get());
+    }
+  }
+
+  // Large entries written on threads of their own into a fork each, as long as threads are
+  // left, sharing the threads left over. The entries before the first of them are written
+  // inline, the others into one sequential fork per run of entries between two large ones,
+  // so that forks are spliced back in order.
+  template<typename... Entries>
+  void serializeTasks(const Entries&... entries) {
+    const std::size_t large = (std::size_t{ this->parallel(weight(entries)) } + ...);
+    const auto tasks = std::min(large, _options.threads - 1);
+
+    std::vector<std::future<Writer>> parts;
+    std::optional<Serializer> run;
+    const auto endRun = [&parts, &run] {
+      if (run) {
+        std::promise<Writer> done;
+        done.set_value(std::move(run->_writer));
+        parts.push_back(done.get_future());
+        run.reset();
+      }
+    };
+
+    std::size_t launched = 0;
+    const auto task = [&](const auto& entry) {
+      if (launched < tasks && this->parallel(weight(entry))) {
+        endRun();
+        const auto threads = share(_options.threads - 1, tasks, launched++);
+        parts.push_back(
+          this->launch(threads, [&entry](auto& part) { part.serializeEntry(entry); }));
+      } else if (parts.empty()) {
+        this->serializeEntry(entry);
+      } else {
+        if (!run) {
+          run.emplace(this->fork(1));
+        }
+        run->serializeEntry(entry);
+      }
+    };
+    (task(entries), ...);
+    endRun();
+
+    for (auto& part : parts) {
+      _writer.splice(part.get());
+    }
+  }
+
+  // Run job on a new thread, over a serializer writing to a fork
+  template<typename Job>
+  std::future<Writer> launch(std::size_t threads, Job job) const {
+    return std::async(std::launch::async, [part = this->fork(threads), job]() mutable {
+      job(part);
+      return std::move(part._writer);
+    });
+  }
+
+  // Serializer writing to a fork of the writer with as many threads, this one included.
+  // The fork keeps the other options, such as the schema version written.
+  Serializer fork(std::size_t threads) const {
+    auto options = _options;
+    options.threads = threads;
+    return Serializer(_writer.fork(), options);
+  }
+
+  // Share of part index among parts of the threads, spread as evenly as possible
+  static std::size_t share(std::size_t threads, std::size_t parts, std::size_t index) {
+    return threads / parts + (index < threads % parts ? 1 : 0);
+  }
+
+  bool parallel(std::size_t weight) const {
+    return _options.threads > 1 && weight >= _options.parallelThreshold;
+  }
+
+  // Item count of an entry's value, sizing up the work of writing it
   template<StringLiteral Name, typename T, typename... Attrs>
-  requires(!Serializable<T, Serializer<Writer>> &&
-           !Detail::Collection<T>) void serializeEntry(const Entry<Name, T, Attrs...>& entry) {
-    _writer.writeEntryStartElement(entry.name);
-    if constexpr (sizeof...(Attrs) > 0) {
-      this->serializeAttributes(entry.attrs);
+  static std::size_t weight(const Entry<Name, T, Attrs...>& entry) {
+    return weightOf(Detail::unwrapRef(entry.value));
+  }
+
+  static std::size_t weight(const auto&) {
+    return 1;
+  }
+
+  template<typename... Entries>
+  static std::size_t weightOf(const std::tuple<Entries...>& children) {
+    return std::apply([](const auto&... entries) { return (weight(entries) + ... + 0); },
+                      children);
+  }
+
+  template<typename T>
+  static std::size_t weightOf(const T& value) {
+    if constexpr (Detail::SerializableRange<T> && std::ranges::sized_range<const T>) {
+      return std::ranges::size(value);
+    } else {
+      return 1;
     }
-    _writer.writeValue(entry.value);
+  }
+
+  // Simple entry
+  template<typename Name, typename T, typename... Attrs>
+  requires(!Serializable<T, Serializer<Writer>> && !Detail::SerializableRange<T>) //
+    void serializeEntry(Name name, const T& value, const std::tuple<Attrs...>& attrs) {
+    _writer.writeEntryStartElement(name);
+    if constexpr (Detail::hasAttrs<Attrs...>) {
+      this->serializeAttributes(Detail::attrRefs(attrs));
+    }
+    _writer.writeValue(value);
     _writer.writeEntryEndElement();
   }
 
   // Serializable object entry
-  template<StringLiteral Name, Serializable<Serializer<Writer>> T, typename... Attrs>
-  void serializeEntry(const Entry<Name, T, Attrs...>& entry) {
-    _writer.writeObjStartElement(entry.name);
-    if constexpr (sizeof...(Attrs) > 0) {
-      this->serializeAttributes(entry.attrs);
+  template<typename Name, Serializable<Serializer<Writer>> T, typename... Attrs>
+  void serializeEntry(Name name, const T& value, const std::tuple<Attrs...>& attrs) {
+    _writer.writeObjStartElement(name);
+    if constexpr (Detail::hasAttrs<Attrs...>) {
+      this->serializeAttributes(Detail::attrRefs(attrs));
     }
-    entry.value.serialize(*this);
+    value.serialize(*this);
     _writer.writeObjEndElement();
   }
 
   // Serializale object
-  void serializeEntry(const Serializable<Serializer<Writer>> auto& entry) {
-    _writer.writeObjStartElement(entry.EntryName);
+  template<Serializable<Serializer<Writer>> T>
+  void serializeEntry(const T& entry) {
+    _writer.writeObjStartElement(this->entryName<T>());
     entry.serialize(*this);
     _writer.writeObjEndElement();
   }
@@ -79,26 +354,65 @@ class Serializer {
     _writer.writeValue(entry);
   }
 
+  // Records transposed into one collection entry per field, learnt from the first record.
+  // Records with fields which can't be stored in a column are written row by row.
+  void serializeColumns(auto name, const auto& records) {
+    const auto size = std::ranges::size(records);
+    if (size == 0) {
+      _writer.writeColumnsStartElement(name, size);
+      _writer.writeObjEndElement();
+      return;
+    }
+
+    const auto write = [this, name, &records, size]<typename... Fields>(const Fields&...) {
+      if constexpr ((Detail::ColumnField<Fields> && ...)) {
+        _writer.writeColumnsStartElement(name, size);
+        Detail::ColumnGather<Fields...> gather(size);
+        for (const auto& record : records) {
+          record.serialize(gather);
+        }
+        std::apply([this](const auto&... columns) { this->serialize(columns...); },
+                   gather.columns);
+        _writer.writeObjEndElement();
+      } else {
+        this->serializeArray(name, records);
+      }
+    };
+    Detail::FieldsProbe probe(write);
+    std::ranges::begin(records)->serialize(probe);
+  }
+
   template<typename... Attrs>
-  void serializeAttributes(std::tuple<Attrs...> attrTuple) {
+  void serializeAttributes(const std::tuple<Attrs...>& attrTuple) {
     _writer.writeAttrStartElement();
     std::apply([this](auto&... attrs) { this->serializeAttributes(attrs...); }, attrTuple);
     _writer.writeAttrEndElement();
   }
 
-  template<typename Attr, typename... Attrs>
-  void serializeAttributes(const Attr& attr, const Attrs&... attrs) {
-    _writer.writeAttr(attr.name, attr.value);
+  template<StringLiteral Name, typename T, typename... Attrs>
+  void serializeAttributes(const Attr<Name, T>& attr, const Attrs&... attrs) {
+    _writer.writeAttr(NameTag<Name>{}, attr.value);
     if constexpr (sizeof...(attrs) > 0) {
       this->serializeAttributes(attrs...);
     }
   }
 
+  // Compile-time name of a Serializable user class
+  template<typename T>
+  static constexpr auto entryName() {
+    constexpr std::string_view name = T::EntryName;
+    return NameTag<StringLiteral<name.size()>(name.data())>{};
+  }
+
  private:
   Writer _writer;
+  SerializerOptions _options;
 };
 
 template<typename Writer>
 Serializer(Writer) -> Serializer<Writer>;
 
+template<typename Writer>
+Serializer(Writer, SerializerOptions) -> Serializer<Writer>;
+
 #endif // !CPPDICT_SERIALIZER_HPP
@@ -0,0 +1,1306 @@
+#ifndef CPPDICT_SERIALIZER_BINARY_HPP
+#define CPPDICT_SERIALIZER_BINARY_HPP
+
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "concepts.hpp"
+#include "encoding.hpp"
+#include "fixed.hpp"
+
+// Compact binary format.
+//
+// element := name [Sized size] [Object | Array count | ObjectAttrs attrs | Attrs attrs] body
+//          | name Block type count bytes
+//          | name (DeltaBlock | PackedBlock) type count size bytes
+//          | name [Sized size] Columns count element* End
+// attrs   := (name value)* End
+// name    := varint length + bytes, a zero length closes the enclosing object
+// body    := element* End (object) | item* (array) | value (entry)
+// item    := value | [Sized size] Object element* End
+// value   := tag payload, integers are (zigzag) varints and strings are length-prefixed
+// Blocks hold arrays of numbers as little-endian fixed-size values,
+// their type is the value kind (BlockKind) in the high nibble and size in the low one.
+// Integer blocks may instead hold zigzag varint deltas between consecutive values
+// (DeltaBlock), or the zigzag varint minimum, a bit width and each value's offset from
+// the minimum bit-packed at that width (PackedBlock).
+// Columns hold collections of user records as one array element per record field.
+// Arrays written without knowing their size up front have their count padded with
+// continuation bytes to CountBytes bytes, patched in place once the array is complete.
+// Objects and arrays may be prefixed by their size in bytes past it as a 4 bytes
+// little-endian integer, letting readers skip unknown ones at once. UnknownSize stands for
+// elements too large to tell, readers then scan them.
+namespace Detail {
+
+  enum class BinaryTag : std::uint8_t {
+    End = 0x00,
+    Object = 0x01,
+    Array = 0x02,
+    Attrs = 0x03,
+    False = 0x04,
+    True = 0x05,
+    UInt = 0x06,
+    SInt = 0x07,
+    Float = 0x08,
+    Double = 0x09,
+    String = 0x0a,
+    ObjectAttrs = 0x0b,
+    Block = 0x0c,
+    DeltaBlock = 0x0d,
+    PackedBlock = 0x0e,
+    Columns = 0x0f,
+    Sized = 0x10,
+  };
+
+  inline constexpr std::size_t SizeBytes = 4;
+  inline constexpr std::size_t CountBytes = 5;
+  inline constexpr std::uint64_t UnknownSize = 0xffffffff;
+
+  enum class BlockKind : std::uint8_t {
+    Unsigned = 0x00,
+    Signed = 0x10,
+    Float = 0x20,
+  };
+
+  template<typename T>
+  concept BlockValue = Number<T> && sizeof(T) <= sizeof(std::uint64_t);
+
+  template<BlockValue T>
+  constexpr std::uint8_t blockType() {
+    const auto kind = std::floating_point<T> ? BlockKind::Float
+      : std::signed_integral<T>              ? BlockKind::Signed
+                                             : BlockKind::Unsigned;
+    return static_cast<std::uint8_t>(kind) | sizeof(T);
+  }
+
+  // Array of numbers encoded as a block, bytes point into the input buffer
+  struct BinaryBlock {
+    BinaryTag tag{ BinaryTag::Block };
+    std::uint8_t type{};
+    std::uint64_t count{};
+    std::string_view bytes;
+  };
+
+  // Convert a block between little-endian and the host order
+  template<std::size_t Size>
+  void swapBlock(char* data, std::size_t count) {
+    if constexpr (std::endian::native == std::endian::big && Size > 1) {
+      for (std::size_t i = 0; i < count; ++i) {
+        std::reverse(data + i * Size, data + (i + 1) * Size);
+      }
+    }
+  }
+
+  // Decoded value token, string payloads point into the input buffer
+  struct BinaryToken {
+    BinaryTag tag{ BinaryTag::End };
+    std::uint64_t bits{};
+    std::string_view str;
+  };
+
+  template<typename T>
+  concept BinaryString = StringLike<T>;
+
+  // Name of the schema fingerprint element heading an input, which can't clash with
+  // entry names since '@' starts the attribute part of a path
+  inline constexpr std::string_view SchemaName = "@Schema";
+
+  inline void putVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+      out.push_back(static_cast<char>(value | 0x80));
+      value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+  }
+
+  // Overwrite size bytes at pos with value as a varint padded with continuation bytes,
+  // value must fit in 7 bits per byte
+  inline void setPaddedVarint(std::string& out,
+                              std::size_t pos,
+                              std::uint64_t value,
+                              std::size_t size) {
+    for (std::size_t i = 0; i + 1 < size; ++i, value >>= 7) {
+      out[pos + i] = static_cast<char>((value & 0x7f) | 0x80);
+    }
+    out[pos + size - 1] = static_cast<char>(value);
+  }
+
+  inline bool getVarint(std::string_view in, std::size_t& pos, std::uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; pos < in.size() && shift < 64; shift += 7) {
+      const auto byte = static_cast<std::uint8_t>(in[pos++]);
+      value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+      if (byte < 0x80) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // std::in_range accepting character types as well
+  template<std::integral T>
+  constexpr bool inRange(auto value) {
+    using Standard =
+      std::conditional_t<std::is_signed_v<T>, std::make_signed_t<T>, std::make_unsigned_t<T>>;
+    return std::in_range<Standard>(value);
+  }
+
+  constexpr std::uint64_t zigzagEncode(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+  }
+
+  constexpr std::int64_t zigzagDecode(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+  }
+
+  inline void putFixed(std::string& out, std::uint64_t bits, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      out.push_back(static_cast<char>(bits >> (8 * i)));
+    }
+  }
+
+  // Overwrite size bytes at pos, reserved by an earlier putFixed()
+  inline void setFixed(std::string& out,
+                       std::size_t pos,
+                       std::uint64_t bits,
+                       std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      out[pos + i] = static_cast<char>(bits >> (8 * i));
+    }
+  }
+
+  inline bool getFixed(std::string_view in,
+                       std::size_t& pos,
+                       std::uint64_t& bits,
+                       std::size_t size) {
+    if (in.size() - pos < size) {
+      return false;
+    }
+    bits = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      bits |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(in[pos++])) << (8 * i);
+    }
+    return true;
+  }
+
+  constexpr std::size_t varintSize(std::uint64_t value) {
+    return (std::bit_width(value | 1) + 6) / 7;
+  }
+
+  constexpr std::uint64_t signExtend(std::uint64_t bits, std::size_t size) {
+    const auto shift = 64 - 8 * size;
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(bits << shift) >> shift);
+  }
+
+  // Up to 8 little-endian bytes at pos, zero padded past the end of in
+  inline std::uint64_t loadWord(std::string_view in, std::size_t pos) {
+    std::uint64_t word = 0;
+    if (in.size() - pos >= sizeof(word)) {
+      std::memcpy(&word, in.data() + pos, sizeof(word));
+      swapBlock<sizeof(word)>(reinterpret_cast<char*>(&word), 1);
+      return word;
+    }
+    for (std::size_t i = 0; pos + i < in.size(); ++i) {
+      word |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(in[pos + i])) << (8 * i);
+    }
+    return word;
+  }
+
+  template<std::integral T>
+  void putDeltas(std::string& out, std::span<const T> values) {
+    const auto deltas = [values](auto&& visitor) {
+      std::uint64_t previous = 0;
+      for (const auto value : values) {
+        const auto current = static_cast<std::uint64_t>(value);
+        visitor(zigzagEncode(static_cast<std::int64_t>(current - previous)));
+        previous = current;
+      }
+    };
+
+    std::size_t size = 0;
+    deltas([&size](std::uint64_t delta) { size += varintSize(delta); });
+    putVarint(out, size);
+    deltas([&out](std::uint64_t delta) { putVarint(out, delta); });
+  }
+
+  // Calls store(value) for each of the count deltas encoded in in. Runs of 8 single byte
+  // deltas, the common case of sorted ids and timestamps, are decoded from one word.
+  template<typename Store>
+  bool getDeltas(std::string_view in, std::uint64_t count, Store&& store) {
+    constexpr std::uint64_t continuationBits = 0x8080808080808080ull;
+
+    std::size_t pos = 0;
+    std::uint64_t previous = 0;
+    std::uint64_t delta = 0;
+    while (count > 0) {
+      if (count >= 8 && in.size() - pos >= 8) {
+        const auto word = loadWord(in, pos);
+        if ((word & continuationBits) == 0) {
+          for (unsigned i = 0; i < 8; ++i) {
+            previous += static_cast<std::uint64_t>(zigzagDecode((word >> (8 * i)) & 0xff));
+            store(previous);
+          }
+          pos += 8;
+          count -= 8;
+          continue;
+        }
+      }
+
+      if (!getVarint(in, pos, delta)) {
+        return false;
+      }
+      previous += static_cast<std::uint64_t>(zigzagDecode(delta));
+      store(previous);
+      --count;
+    }
+    return pos == in.size();
+  }
+
+  template<std::integral T>
+  void putPacked(std::string& out, std::span<const T> values) {
+    const auto [min, max] = std::ranges::minmax(values);
+    const auto base = static_cast<std::uint64_t>(min);
+    const auto encodedBase = std::signed_integral<T> ? zigzagEncode(min) : base;
+    // A non zero width bounds the item count by the payload size
+    const auto range = static_cast<std::uint64_t>(max) - base;
+    const auto width = std::max<unsigned>(std::bit_width(range), 1);
+    const auto payload = (values.size() * width + 7) / 8;
+
+    putVarint(out, varintSize(encodedBase) + 1 + payload);
+    putVarint(out, encodedBase);
+    out.push_back(static_cast<char>(width));
+
+    std::uint64_t word = 0;
+    unsigned used = 0;
+    for (const auto value : values) {
+      const auto offset = static_cast<std::uint64_t>(value) - base;
+      word |= offset << used;
+      used += width;
+      if (used >= 64) {
+        putFixed(out, word, sizeof(word));
+        used -= 64;
+        word = used > 0 ? offset >> (width - used) : 0;
+      }
+    }
+    putFixed(out, word, (used + 7) / 8);
+  }
+
+  // Calls store(value) for each of the count values packed in in
+  template<typename Store>
+  bool getPacked(std::string_view in, std::uint64_t count, bool isSigned, Store&& store) {
+    std::size_t pos = 0;
+    std::uint64_t base = 0;
+    if (!getVarint(in, pos, base) || pos >= in.size()) {
+      return false;
+    }
+    if (isSigned) {
+      base = static_cast<std::uint64_t>(zigzagDecode(base));
+    }
+    const auto width = static_cast<std::uint8_t>(in[pos++]);
+    const auto bits = in.substr(pos);
+    if (width == 0 || width > 64 || count > bits.size() * 8 / width ||
+        bits.size() != (count * width + 7) / 8) {
+      return false;
+    }
+
+    const auto mask = width == 64 ? ~std::uint64_t{} : (std::uint64_t{ 1 } << width) - 1;
+    for (std::uint64_t i = 0, bit = 0; i < count; ++i, bit += width) {
+      const auto byte = bit / 8;
+      const auto shift = bit % 8;
+      auto offset = loadWord(bits, byte) >> shift;
+      if (shift > 0 && byte + 8 < bits.size()) {
+        offset |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(bits[byte + 8]))
+          << (64 - shift);
+      }
+      store(base + (offset & mask));
+    }
+    return true;
+  }
+
+  // Fixed capacity stack tracking the nesting of the element being decoded
+  template<typename T, std::size_t Capacity>
+  class BinaryFrames {
+   public:
+    bool push_back(const T& frame) {
+      if (_size == Capacity) {
+        return false;
+      }
+      _frames[_size++] = frame;
+      return true;
+    }
+
+    void pop_back() {
+      --_size;
+    }
+
+    T& back() {
+      return _frames[_size - 1];
+    }
+
+    const T& back() const {
+      return _frames[_size - 1];
+    }
+
+    bool empty() const {
+      return _size == 0;
+    }
+
+   private:
+    std::array<T, Capacity> _frames{};
+    std::size_t _size{};
+  };
+
+} // namespace Detail
+
+struct BinaryWriterOptions {
+  // Prefix objects and arrays with their size so that readers unaware of them skip them in
+  // O(1), such as entries added by a newer version of a schema. Costs 5 bytes per element.
+  // Unprefixed elements are skipped by scanning them, in O(size).
+  bool sizedObjects{};
+};
+
+struct BinaryWriter {
+  explicit BinaryWriter(std::shared_ptr<std::string> buffer, BinaryWriterOptions options = {})
+    : _buffer(std::move(buffer))
+    , _options(options) {}
+
+ public:
+  void write(std::string_view name, const auto& value) {
+    this->writeEntryStartElement(name);
+    this->writeValue(value);
+    this->writeEntryEndElement();
+  }
+
+  void write(std::string_view name) {
+    this->writeObjStartElement(name);
+    this->writeObjEndElement();
+  }
+
+  void writeValue(const auto& value) {
+    this->countItem();
+    this->putValue(value);
+  }
+
+  void writeObjStartElement(std::string_view name) {
+    this->putName(name);
+    const auto sizePos = this->putSize();
+    this->putTag(Detail::BinaryTag::Object);
+    _frames.push_back({ .kind = Frame::Object, .sizePos = sizePos });
+  }
+
+  void writeObjEndElement() {
+    this->putTag(Detail::BinaryTag::End);
+    this->setSize(_frames.back().sizePos);
+    _frames.pop_back();
+  }
+
+  // Contiguous numbers are copied as one block rather than item by item,
+  // integers may be delta or bit-packed encoded on request
+  template<Detail::BlockValue T, EncodingKind Kind>
+  void writeArrayBlock(std::string_view name, std::span<const T> values, Encoding<Kind>) {
+    constexpr bool encoded =
+      std::integral<T> && (Kind == EncodingKind::Delta || Kind == EncodingKind::Packed);
+    const auto tag = !encoded || values.empty() ? Detail::BinaryTag::Block
+      : Kind == EncodingKind::Delta              ? Detail::BinaryTag::DeltaBlock
+                                                 : Detail::BinaryTag::PackedBlock;
+
+    this->putName(name);
+    this->putTag(tag);
+    _buffer->push_back(static_cast<char>(Detail::blockType<T>()));
+    Detail::putVarint(*_buffer, values.size());
+    if (values.empty()) {
+      return;
+    }
+
+    if constexpr (encoded) {
+      if constexpr (Kind == EncodingKind::Delta) {
+        Detail::putDeltas(*_buffer, values);
+      } else {
+        Detail::putPacked(*_buffer, values);
+      }
+      return;
+    }
+
+    const auto offset = _buffer->size();
+    _buffer->resize(offset + values.size_bytes());
+    std::memcpy(_buffer->data() + offset, values.data(), values.size_bytes());
+    Detail::swapBlock<sizeof(T)>(_buffer->data() + offset, values.size());
+  }
+
+  // Collection of count records written as one array per field, closed by writeObjEndElement()
+  void writeColumnsStartElement(std::string_view name, std::size_t count) {
+    this->putName(name);
+    const auto sizePos = this->putSize();
+    this->putTag(Detail::BinaryTag::Columns);
+    Detail::putVarint(*_buffer, count);
+    _frames.push_back({ .kind = Frame::Object, .sizePos = sizePos });
+  }
+
+  // The item count is reserved, then written by writeArraySize() or once the array ends
+  void writeArrayStartElement(std::string_view name) {
+    this->putName(name);
+    const auto sizePos = this->putSize();
+    this->putTag(Detail::BinaryTag::Array);
+    _frames.push_back(
+      { .kind = Frame::Array, .sizePos = sizePos, .countPos = _buffer->size() });
+    _buffer->append(Detail::CountBytes, '\0');
+  }
+
+  // Size of the array just started, written in place of its reserved count
+  void writeArraySize(std::size_t size) {
+    _buffer->resize(_frames.back().countPos);
+    Detail::putVarint(*_buffer, size);
+    _frames.back().sized = true;
+  }
+
+  void writeArrayEndElement() {
+    const auto& frame = _frames.back();
+    if (!frame.sized) {
+      if (frame.count < std::uint64_t{ 1 } << (7 * Detail::CountBytes)) {
+        Detail::setPaddedVarint(*_buffer, frame.countPos, frame.count, Detail::CountBytes);
+      } else {
+        std::string count;
+        Detail::putVarint(count, frame.count);
+        _buffer->replace(frame.countPos, Detail::CountBytes, count);
+      }
+    }
+    this->setSize(frame.sizePos);
+    _frames.pop_back();
+  }
+
+  void writeEntryStartElement(std::string_view name) {
+    this->putName(name);
+    _frames.push_back({ .kind = Frame::Entry });
+  }
+
+  void writeEntryEndElement() {
+    _frames.pop_back();
+  }
+
+  void writeAttr(std::string_view name, const auto& value) {
+    this->putString(name);
+    this->putValue(value);
+  }
+
+  // Fingerprint of the schema of the entries written next, readers unaware of it
+  // skip it as an unknown entry
+  void writeSchema(std::uint64_t schema) {
+    this->write(Detail::SchemaName, schema);
+  }
+
+  // Writer continuing from the current element into a buffer of its own,
+  // array items written to it are counted by splice()
+  BinaryWriter fork() const {
+    BinaryWriter part(std::make_shared<std::string>(), _options);
+    if (!_frames.empty()) {
+      part._frames.push_back({ .kind = _frames.back().kind, .sized = true });
+    }
+    return part;
+  }
+
+  void splice(const BinaryWriter& part) {
+    _buffer->append(*part._buffer);
+    if (!_frames.empty() && !part._frames.empty()) {
+      _frames.back().count += part._frames.back().count;
+    }
+  }
+
+  void writeAttrStartElement() {
+    // Object attributes are flagged on the object tag itself so they can't be
+    // mistaken for the length of the first child name
+    if (_frames.back().kind == Frame::Object) {
+      _buffer->back() = static_cast<char>(Detail::BinaryTag::ObjectAttrs);
+      return;
+    }
+    this->putTag(Detail::BinaryTag::Attrs);
+  }
+
+  void writeAttrEndElement() {
+    this->putTag(Detail::BinaryTag::End);
+  }
+
+ private:
+  struct Frame {
+    enum Kind { Object, Array, Entry } kind;
+    std::size_t sizePos{};  // Position of the size prefix, 0 when unsized
+    std::size_t countPos{}; // Position of the item count of arrays
+    std::size_t count{};
+    bool sized{}; // Item count written up front
+  };
+
+  // Array items are anonymous, only their count is stored
+  void putName(std::string_view name) {
+    if (!this->countItem()) {
+      this->putString(name);
+    }
+  }
+
+  bool countItem() {
+    if (_frames.empty() || _frames.back().kind != Frame::Array) {
+      return false;
+    }
+    ++_frames.back().count;
+    return true;
+  }
+
+  void putTag(Detail::BinaryTag tag) {
+    _buffer->push_back(static_cast<char>(tag));
+  }
+
+  // Reserve the size of the object or array starting, returns its position or 0 when unsized
+  std::size_t putSize() {
+    if (!_options.sizedObjects) {
+      return 0;
+    }
+    this->putTag(Detail::BinaryTag::Sized);
+    const auto pos = _buffer->size();
+    Detail::putFixed(*_buffer, 0, Detail::SizeBytes);
+    return pos;
+  }
+
+  // Patch the size reserved at pos once the element is complete, the bytes written since
+  // never move
+  void setSize(std::size_t pos) {
+    if (pos != 0) {
+      const auto size = _buffer->size() - pos - Detail::SizeBytes;
+      Detail::setFixed(
+        *_buffer, pos, std::min<std::uint64_t>(size, Detail::UnknownSize), Detail::SizeBytes);
+    }
+  }
+
+  void putString(std::string_view str) {
+    Detail::putVarint(*_buffer, str.size());
+    _buffer->append(str);
+  }
+
+  void putValue(bool value) {
+    this->putTag(value ? Detail::BinaryTag::True : Detail::BinaryTag::False);
+  }
+
+  void putValue(std::unsigned_integral auto value) {
+    this->putTag(Detail::BinaryTag::UInt);
+    Detail::putVarint(*_buffer, value);
+  }
+
+  void putValue(std::signed_integral auto value) {
+    this->putTag(Detail::BinaryTag::SInt);
+    Detail::putVarint(*_buffer, Detail::zigzagEncode(value));
+  }
+
+  void putValue(float value) {
+    this->putTag(Detail::BinaryTag::Float);
+    Detail::putFixed(*_buffer, std::bit_cast<std::uint32_t>(value), sizeof(value));
+  }
+
+  void putValue(double value) {
+    this->putTag(Detail::BinaryTag::Double);
+    Detail::putFixed(*_buffer, std::bit_cast<std::uint64_t>(value), sizeof(value));
+  }
+
+  void putValue(const Detail::BinaryString auto& value) {
+    this->putTag(Detail::BinaryTag::String);
+    this->putString(value);
+  }
+
+ private:
+  std::shared_ptr<std::string> _buffer;
+  BinaryWriterOptions _options;
+  std::vector<Frame> _frames;
+};
+
+struct BinaryReader {
+  explicit BinaryReader(std::string_view input)
+    : _input(input) {}
+
+  // The returned name points into the input buffer
+  [[nodiscard]] std::pair<std::string_view, bool> nextEntryName() {
+    std::string_view name;
+    if (!this->readName(name)) {
+      return { {}, false };
+    }
+
+    return { name, this->readHeader() };
+  }
+
+  // Skip the rest of the element returned by the last nextEntryName()
+  bool skipEntry() {
+    if (this->arrayBlock()) {
+      return true;
+    }
+    if (!_entered) {
+      Detail::BinaryToken token;
+      return this->readToken(token);
+    }
+
+    const auto frame = _frames.back();
+    _frames.pop_back();
+    if (frame.end != 0) {
+      _pos = frame.end;
+      return true;
+    }
+    return frame.kind == Frame::Object ? skipObject(_input, _pos)
+                                       : skipItems(_input, _pos, frame.remaining);
+  }
+
+  bool nextArrayEntry() {
+    if (_frames.empty() || _frames.back().kind != Frame::Array) {
+      return false;
+    }
+    if (_frames.back().remaining == 0) {
+      _frames.pop_back();
+      return false;
+    }
+
+    --_frames.back().remaining;
+    _attrs = {};
+    _columns = std::nullopt;
+    std::size_t end = 0;
+    if (this->peekTag() == Detail::BinaryTag::Sized && !readSize(_input, _pos, end)) {
+      return false;
+    }
+    if (this->peekTag() == Detail::BinaryTag::Object) {
+      ++_pos;
+      return _frames.push_back({ Frame::Object, 0, end });
+    }
+    return true;
+  }
+
+  // Schema fingerprint heading the input, consumed when present
+  std::optional<std::uint64_t> readSchema() {
+    auto pos = _pos;
+    std::string_view name;
+    Detail::BinaryToken token;
+    if (pos != 0 || !_frames.empty() || !this->readString(_input, pos, name) ||
+        name != Detail::SchemaName || !this->readToken(_input, pos, token) ||
+        token.tag != Detail::BinaryTag::UInt) {
+      return std::nullopt;
+    }
+    _pos = pos;
+    return token.bits;
+  }
+
+  // Split the items left in the array entered by the last nextEntryName() into consecutive
+  // runs found by a structural scan, one reader each. This reader moves past the array,
+  // unless nothing is returned because the array is empty or malformed.
+  std::vector<BinaryReader> splitArray(std::size_t parts) {
+    std::vector<BinaryReader> readers;
+    if (_frames.empty() || _frames.back().kind != Frame::Array ||
+        _frames.back().remaining == 0) {
+      return readers;
+    }
+
+    const auto count = _frames.back().remaining;
+    parts = static_cast<std::size_t>(std::clamp<std::uint64_t>(parts, 1, count));
+    readers.reserve(parts);
+    auto begin = _pos;
+    for (std::size_t part = 0; part < parts; ++part) {
+      const auto items = count * (part + 1) / parts - count * part / parts;
+      auto end = begin;
+      if (!skipItems(_input, end, items)) {
+        return {};
+      }
+      auto& reader = readers.emplace_back(_input.substr(begin, end - begin));
+      reader._frames.push_back({ Frame::Array, items });
+      begin = end;
+    }
+
+    _pos = begin;
+    _frames.pop_back();
+    return readers;
+  }
+
+  // Record count of the columns entered by the last nextEntryName()
+  std::optional<std::size_t> columnCount() const {
+    return _columns;
+  }
+
+  // Item count of the array entered by the last nextEntryName()
+  std::optional<std::size_t> arraySize() const {
+    if (_frames.empty() || _frames.back().kind != Frame::Array) {
+      return std::nullopt;
+    }
+    return _frames.back().remaining;
+  }
+
+  // Whether the last nextEntryName() returned an array of numbers stored as a block
+  bool arrayBlock() const {
+    return _block.type != 0;
+  }
+
+  // Decode the block with a single copy when the encoded and target types agree,
+  // value by value with range checks otherwise. Collections are resized to the block,
+  // other ranges such as views over the fields of records must hold as many items.
+  template<typename T>
+  requires std::ranges::random_access_range<T> && std::ranges::sized_range<T> &&
+    Detail::Number<std::ranges::range_value_t<T>>
+  std::errc readArrayBlock(T& values) {
+    using Value = std::ranges::range_value_t<T>;
+    if constexpr (requires { Detail::resizeItems(values, std::size_t{}); }) {
+      if (!Detail::resizeItems(values, _block.count)) {
+        return std::errc::value_too_large;
+      }
+    } else if (std::ranges::size(values) != _block.count) {
+      return std::errc::invalid_argument;
+    }
+    if (_block.count == 0) {
+      return {};
+    }
+
+    bool exact = false;
+    if constexpr (Detail::BlockValue<Value>) {
+      exact = _block.type == Detail::blockType<Value>();
+      if constexpr (std::ranges::contiguous_range<T>) {
+        if (exact && _block.tag == Detail::BinaryTag::Block) {
+          std::memcpy(std::ranges::data(values), _block.bytes.data(), _block.bytes.size());
+          Detail::swapBlock<sizeof(Value)>(
+            reinterpret_cast<char*>(std::ranges::data(values)), _block.count);
+          return {};
+        }
+      }
+    }
+
+    std::errc error{};
+    auto it = std::ranges::begin(values);
+    const auto store = [&](std::uint64_t bits) {
+      if constexpr (std::integral<Value>) {
+        if (exact) {
+          *it++ = static_cast<Value>(bits);
+          return;
+        }
+      }
+      if (const auto result = setValue(*it++, blockToken(_block.type, bits));
+          error == std::errc{}) {
+        error = result;
+      }
+    };
+
+    const auto kind = static_cast<Detail::BlockKind>(_block.type & 0xf0);
+    const bool isSigned = kind == Detail::BlockKind::Signed;
+    bool valid = true;
+    switch (_block.tag) {
+    case Detail::BinaryTag::DeltaBlock:
+      valid = Detail::getDeltas(_block.bytes, _block.count, store);
+      break;
+    case Detail::BinaryTag::PackedBlock:
+      valid = Detail::getPacked(_block.bytes, _block.count, isSigned, store);
+      break;
+    default: {
+      const std::size_t size = _block.type & 0x0f;
+      std::uint64_t bits = 0;
+      for (std::size_t pos = 0; pos < _block.bytes.size();) {
+        Detail::getFixed(_block.bytes, pos, bits, size);
+        store(isSigned ? Detail::signExtend(bits, size) : bits);
+      }
+      break;
+    }
+    }
+    return valid ? error : std::errc::invalid_argument;
+  }
+
+  std::errc value(auto& value) {
+    Detail::BinaryToken token;
+    if (!this->readToken(token)) {
+      return std::errc::invalid_argument;
+    }
+    return this->setValue(value, token);
+  }
+
+  std::errc attrValue(std::string_view name, auto& value) const {
+    std::size_t pos = 0;
+    std::string_view attrName;
+    Detail::BinaryToken token;
+    while (this->readString(_attrs, pos, attrName) && this->readToken(_attrs, pos, token)) {
+      if (attrName == name) {
+        return this->setValue(value, token);
+      }
+    }
+    return {};
+  }
+
+  template<typename Visitor>
+  void readAttrs(Visitor&& visitor) const {
+    std::size_t pos = 0;
+    std::string_view name;
+    Detail::BinaryToken token;
+    while (this->readString(_attrs, pos, name) && !name.empty() &&
+           this->readToken(_attrs, pos, token)) {
+      visitor(name, [&token](auto& value) { return setValue(value, token); });
+    }
+  }
+
+ private:
+  friend class BinaryIndex;
+
+  static constexpr std::size_t MaxDepth = 64;
+
+  struct Frame {
+    enum Kind { Object, Array } kind;
+    std::uint64_t remaining{};
+    std::size_t end{}; // One past the end of sized objects and arrays, 0 otherwise
+  };
+
+  bool readName(std::string_view& name) {
+    if (_pos >= _input.size()) {
+      return false;
+    }
+    if (!this->readString(_input, _pos, name)) {
+      _pos = _input.size();
+      return false;
+    }
+    if (name.empty()) {
+      // End of the enclosing object
+      if (!_frames.empty()) {
+        _frames.pop_back();
+      }
+      return false;
+    }
+    return true;
+  }
+
+  // Consume the element kind and attribute block following a name
+  bool readHeader() {
+    _attrs = {};
+    _block = {};
+    _columns = std::nullopt;
+    _entered = false;
+    bool hasAttrs = false;
+    std::size_t end = 0;
+    if (this->peekTag() == Detail::BinaryTag::Sized && !readSize(_input, _pos, end)) {
+      return false;
+    }
+
+    switch (this->peekTag()) {
+    case Detail::BinaryTag::Columns: {
+      std::uint64_t count = 0;
+      ++_pos;
+      if (!Detail::getVarint(_input, _pos, count) ||
+          !_frames.push_back({ Frame::Object, 0, end })) {
+        return false;
+      }
+      _columns = count;
+      _entered = true;
+      return true;
+    }
+    case Detail::BinaryTag::Block:
+    case Detail::BinaryTag::DeltaBlock:
+    case Detail::BinaryTag::PackedBlock: return readBlock(_input, _pos, _block);
+    case Detail::BinaryTag::ObjectAttrs: hasAttrs = true; [[fallthrough]];
+    case Detail::BinaryTag::Object:
+      ++_pos;
+      if (!_frames.push_back({ Frame::Object, 0, end })) {
+        return false;
+      }
+      _entered = true;
+      break;
+    case Detail::BinaryTag::Array: {
+      std::uint64_t count = 0;
+      ++_pos;
+      if (!Detail::getVarint(_input, _pos, count) ||
+          !_frames.push_back({ Frame::Array, count, end })) {
+        return false;
+      }
+      _entered = true;
+      break;
+    }
+    case Detail::BinaryTag::Attrs:
+      ++_pos;
+      hasAttrs = true;
+      break;
+    default: break;
+    }
+
+    if (hasAttrs) {
+      const auto begin = _pos;
+      if (!skipAttrs(_input, _pos)) {
+        return false;
+      }
+      _attrs = _input.substr(begin, _pos - begin);
+    }
+    return true;
+  }
+
+  // Structural scan over encoded elements, used to skip them without decoding
+
+  static bool skipAttrs(std::string_view in, std::size_t& pos) {
+    std::string_view name;
+    Detail::BinaryToken token;
+    while (readString(in, pos, name)) {
+      if (name.empty()) {
+        return true;
+      }
+      if (!readToken(in, pos, token)) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  // Size prefix of an object, end is left to 0 when the object is too large to tell
+  static bool readSize(std::string_view in, std::size_t& pos, std::size_t& end) {
+    std::uint64_t size = 0;
+    if (!Detail::getFixed(in, ++pos, size, Detail::SizeBytes) ||
+        (size != Detail::UnknownSize && size > in.size() - pos)) {
+      return false;
+    }
+    end = size != Detail::UnknownSize ? pos + size : 0;
+    return true;
+  }
+
+  // Element following its name
+  static bool skipElement(std::string_view in, std::size_t& pos) {
+    Detail::BinaryToken token;
+    Detail::BinaryBlock block;
+    std::uint64_t count = 0;
+    std::size_t end = 0;
+    switch (peekTag(in, pos)) {
+    case Detail::BinaryTag::Sized:
+      if (!readSize(in, pos, end)) {
+        return false;
+      }
+      if (end == 0) {
+        return skipElement(in, pos);
+      }
+      pos = end;
+      return true;
+    case Detail::BinaryTag::Object: return skipObject(in, ++pos);
+    case Detail::BinaryTag::Columns:
+      return Detail::getVarint(in, ++pos, count) && skipObject(in, pos);
+    case Detail::BinaryTag::ObjectAttrs: return skipAttrs(in, ++pos) && skipObject(in, pos);
+    case Detail::BinaryTag::Array:
+      return Detail::getVarint(in, ++pos, count) && skipItems(in, pos, count);
+    case Detail::BinaryTag::Attrs: return skipAttrs(in, ++pos) && readToken(in, pos, token);
+    case Detail::BinaryTag::Block:
+    case Detail::BinaryTag::DeltaBlock:
+    case Detail::BinaryTag::PackedBlock: return readBlock(in, pos, block);
+    default: return readToken(in, pos, token);
+    }
+  }
+
+  // Block starting at its tag
+  static bool readBlock(std::string_view in, std::size_t& pos, Detail::BinaryBlock& block) {
+    if (in.size() - pos < 2) {
+      return false;
+    }
+    block.tag = static_cast<Detail::BinaryTag>(in[pos++]);
+    block.type = static_cast<std::uint8_t>(in[pos++]);
+    const std::size_t size = block.type & 0x0f;
+    const auto kind = static_cast<Detail::BlockKind>(block.type & 0xf0);
+    const bool floating = kind == Detail::BlockKind::Float;
+    const bool encoded = block.tag != Detail::BinaryTag::Block;
+    bool valid = std::has_single_bit(size) && size <= sizeof(std::uint64_t) &&
+      kind <= Detail::BlockKind::Float && (!floating || (size >= sizeof(float) && !encoded)) &&
+      Detail::getVarint(in, pos, block.count);
+
+    // Every value takes at least one byte of a delta block and one bit of a packed one
+    std::uint64_t bytes = block.count * size;
+    if (valid && encoded) {
+      valid = Detail::getVarint(in, pos, bytes) && bytes <= in.size() - pos &&
+        block.count <= (block.tag == Detail::BinaryTag::DeltaBlock ? bytes : bytes * 8);
+    } else if (valid) {
+      valid = block.count <= (in.size() - pos) / size;
+    }
+    if (!valid) {
+      block = {};
+      return false;
+    }
+
+    block.bytes = in.substr(pos, bytes);
+    pos += block.bytes.size();
+    return true;
+  }
+
+  // Block value widened to 64 bits, as the token it would have been encoded to
+  static Detail::BinaryToken blockToken(std::uint8_t type, std::uint64_t bits) {
+    switch (static_cast<Detail::BlockKind>(type & 0xf0)) {
+    case Detail::BlockKind::Unsigned: return { Detail::BinaryTag::UInt, bits, {} };
+    case Detail::BlockKind::Signed:
+      return { Detail::BinaryTag::SInt,
+               Detail::zigzagEncode(static_cast<std::int64_t>(bits)),
+               {} };
+    default:
+      return { (type & 0x0f) == sizeof(float) ? Detail::BinaryTag::Float
+                                              : Detail::BinaryTag::Double,
+               bits,
+               {} };
+    }
+  }
+
+  // Object children up to and including its End marker
+  static bool skipObject(std::string_view in, std::size_t& pos) {
+    std::string_view name;
+    while (readString(in, pos, name)) {
+      if (name.empty()) {
+        return true;
+      }
+      if (!skipElement(in, pos)) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  static bool skipItems(std::string_view in, std::size_t& pos, std::uint64_t count) {
+    Detail::BinaryToken token;
+    for (; count > 0; --count) {
+      const auto tag = peekTag(in, pos);
+      const bool valid = tag == Detail::BinaryTag::Object ? skipObject(in, ++pos)
+        : tag == Detail::BinaryTag::Sized                  ? skipElement(in, pos)
+                                                           : readToken(in, pos, token);
+      if (!valid) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Detail::BinaryTag peekTag() const {
+    return peekTag(_input, _pos);
+  }
+
+  static Detail::BinaryTag peekTag(std::string_view in, std::size_t pos) {
+    return pos < in.size() ? static_cast<Detail::BinaryTag>(in[pos]) : Detail::BinaryTag::End;
+  }
+
+  bool readToken(Detail::BinaryToken& token) {
+    return this->readToken(_input, _pos, token);
+  }
+
+  static bool readString(std::string_view in, std::size_t& pos, std::string_view& str) {
+    std::uint64_t size = 0;
+    if (!Detail::getVarint(in, pos, size) || in.size() - pos < size) {
+      return false;
+    }
+    str = in.substr(pos, size);
+    pos += size;
+    return true;
+  }
+
+  static bool readToken(std::string_view in, std::size_t& pos, Detail::BinaryToken& token) {
+    if (pos >= in.size()) {
+      return false;
+    }
+
+    token.tag = static_cast<Detail::BinaryTag>(in[pos++]);
+    switch (token.tag) {
+    case Detail::BinaryTag::False:
+    case Detail::BinaryTag::True: return true;
+    case Detail::BinaryTag::UInt:
+    case Detail::BinaryTag::SInt: return Detail::getVarint(in, pos, token.bits);
+    case Detail::BinaryTag::Float: return Detail::getFixed(in, pos, token.bits, sizeof(float));
+    case Detail::BinaryTag::Double:
+      return Detail::getFixed(in, pos, token.bits, sizeof(double));
+    case Detail::BinaryTag::String: return readString(in, pos, token.str);
+    default: return false;
+    }
+  }
+
+  static std::errc setValue(bool& value, const Detail::BinaryToken& token) {
+    if (token.tag != Detail::BinaryTag::True && token.tag != Detail::BinaryTag::False) {
+      return std::errc::invalid_argument;
+    }
+    value = token.tag == Detail::BinaryTag::True;
+    return {};
+  }
+
+  template<std::integral T>
+  static std::errc setValue(T& value, const Detail::BinaryToken& token) {
+    switch (token.tag) {
+    case Detail::BinaryTag::UInt:
+      if (!Detail::inRange<T>(token.bits)) {
+        return std::errc::result_out_of_range;
+      }
+      value = static_cast<T>(token.bits);
+      return {};
+    case Detail::BinaryTag::SInt:
+      if (!Detail::inRange<T>(Detail::zigzagDecode(token.bits))) {
+        return std::errc::result_out_of_range;
+      }
+      value = static_cast<T>(Detail::zigzagDecode(token.bits));
+      return {};
+    default: return std::errc::invalid_argument;
+    }
+  }
+
+  template<std::floating_point T>
+  static std::errc setValue(T& value, const Detail::BinaryToken& token) {
+    switch (token.tag) {
+    case Detail::BinaryTag::Float:
+      value = std::bit_cast<float>(static_cast<std::uint32_t>(token.bits));
+      return {};
+    case Detail::BinaryTag::Double:
+      value = static_cast<T>(std::bit_cast<double>(token.bits));
+      return {};
+    default: return std::errc::invalid_argument;
+    }
+  }
+
+  template<typename Allocator>
+  static std::errc setValue(std::basic_string<char, std::char_traits<char>, Allocator>& value,
+                            const Detail::BinaryToken& token) {
+    if (token.tag != Detail::BinaryTag::String) {
+      return std::errc::invalid_argument;
+    }
+    value.assign(token.str);
+    return {};
+  }
+
+  template<std::size_t N>
+  static std::errc setValue(FixedString<N>& value, const Detail::BinaryToken& token) {
+    if (token.tag != Detail::BinaryTag::String) {
+      return std::errc::invalid_argument;
+    }
+    return value.assign(token.str) ? std::errc{} : std::errc::value_too_large;
+  }
+
+ private:
+  std::string_view _input;
+  std::size_t _pos{};
+  std::string_view _attrs;
+  Detail::BinaryBlock _block;
+  std::optional<std::size_t> _columns;
+  bool _entered{};
+  Detail::BinaryFrames<Frame, MaxDepth> _frames;
+};
+
+// Byte offsets of every named element of an encoded buffer, built by one structural pass.
+// Elements are looked up by path ("Root/Child/Bool") and decoded on their own through
+// reader(), the index being read-only it can be shared by several consumers of a buffer.
+class BinaryIndex {
+ public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  BinaryIndex() = default;
+
+  explicit BinaryIndex(std::string_view input) {
+    this->build(input);
+  }
+
+  // Index a new buffer, keeping the storage of the previous one
+  bool build(std::string_view input) {
+    _input = input;
+    _nodes.clear();
+
+    std::size_t pos = 0;
+    while (pos < input.size()) {
+      if (!this->indexElement(pos, npos)) {
+        _nodes.clear();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Element at path, npos when the buffer doesn't contain it
+  std::size_t find(std::string_view path) const {
+    std::size_t node = npos;
+    std::size_t first = 0;
+    std::size_t last = _nodes.size();
+    while (true) {
+      const auto pos = path.find('/');
+      const auto key = path.substr(0, pos);
+      node = this->findChild(first, last, key);
+      if (node == npos || pos == path.npos) {
+        return node;
+      }
+      path.remove_prefix(pos + 1);
+      first = node + 1;
+      last = _nodes[node].end;
+    }
+  }
+
+  std::size_t parent(std::size_t node) const {
+    return _nodes[node].parent;
+  }
+
+  std::size_t size() const {
+    return _nodes.size();
+  }
+
+  // Reader positioned on the element, for a Deserializer::deserializeAt() call
+  BinaryReader reader(std::size_t node) const {
+    return BinaryReader(_input.substr(_nodes[node].offset));
+  }
+
+ private:
+  struct Node {
+    std::string_view name;
+    std::size_t offset{};
+    std::size_t parent{};
+    std::size_t end{}; // One past the last node of the subtree
+  };
+
+  bool indexElement(std::size_t& pos, std::size_t parent) {
+    const auto offset = pos;
+    std::string_view name;
+    if (!BinaryReader::readString(_input, pos, name) || name.empty()) {
+      return false;
+    }
+
+    // Sized objects are indexed as the others, their children being looked up as well.
+    // Other sized elements are jumped over.
+    std::size_t end = 0;
+    if (BinaryReader::peekTag(_input, pos) == Detail::BinaryTag::Sized &&
+        !BinaryReader::readSize(_input, pos, end)) {
+      return false;
+    }
+
+    const auto node = _nodes.size();
+    _nodes.push_back({ name, offset, parent });
+    bool valid = true;
+    switch (BinaryReader::peekTag(_input, pos)) {
+    case Detail::BinaryTag::ObjectAttrs:
+      valid = BinaryReader::skipAttrs(_input, ++pos) && this->indexObject(pos, node);
+      break;
+    case Detail::BinaryTag::Object: valid = this->indexObject(++pos, node); break;
+    default:
+      if (end != 0) {
+        pos = end;
+      } else {
+        valid = BinaryReader::skipElement(_input, pos);
+      }
+      break;
+    }
+    _nodes[node].end = _nodes.size();
+    return valid;
+  }
+
+  // Object children up to and including its End marker
+  bool indexObject(std::size_t& pos, std::size_t parent) {
+    while (BinaryReader::peekTag(_input, pos) != Detail::BinaryTag::End) {
+      if (!this->indexElement(pos, parent)) {
+        return false;
+      }
+    }
+    return ++pos <= _input.size();
+  }
+
+  std::size_t findChild(std::size_t first, std::size_t last, std::string_view name) const {
+    for (auto node = first; node < last; node = _nodes[node].end) {
+      if (_nodes[node].name == name) {
+        return node;
+      }
+    }
+    return npos;
+  }
+
+ private:
+  std::string_view _input;
+  std::vector<Node> _nodes;
+};
+
+#endif // !CPPDICT_SERIALIZER_BINARY_HPP
@@ -1,46 +1,59 @@
 #ifndef CPPDICT_SERIALIZER_QT_XML_HPP
 #define CPPDICT_SERIALIZER_QT_XML_HPP
 
+#include <charconv>
 #include <concepts>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
 #include "concepts.hpp"
+#include "parse.hpp"
+#include "stringLiteral.hpp"
 
-template<typename T>
-concept Unspecified = not std::integral<T> and not Detail::IsAnyOf<T, std::string, bool>;
+// Element and attribute names are converted to QString once per compile-time name
+template<StringLiteral Name>
+const QString& qtName(NameTag<Name>) {
+  static const QString name = QString::fromUtf8(Name.value.data(), Name.view().size());
+  return name;
+}
+
+inline QString qtName(std::string_view name) {
+  return QString::fromUtf8(name.data(), static_cast<int>(name.size()));
+}
 
 struct QtStreamWriter {
   explicit QtStreamWriter(std::shared_ptr<QXmlStreamWriter> writer)
     : _writer(std::move(writer)) {}
 
  public:
-  void write(std::string_view name, const auto& value) {
-    _writer->writeTextElement(QString(name.data()), this->qstringValue(value));
+  void write(const auto& name, const auto& value) {
+    _writer->writeTextElement(qtName(name), this->qstringValue(value));
   }
 
-  void write(std::string_view name) {
-    _writer->writeEmptyElement(QString(name.data()));
+  void write(const auto& name) {
+    _writer->writeEmptyElement(qtName(name));
   }
 
   void writeValue(const auto& value) {
     _writer->writeCharacters(this->qstringValue(value));
   }
 
-  void writeObjStartElement(std::string_view name) {
-    _writer->writeStartElement(QString(name.data()));
+  void writeObjStartElement(const auto& name) {
+    _writer->writeStartElement(qtName(name));
   }
 
   void writeObjEndElement() {
     _writer->writeEndElement();
   }
 
-  void writeArrayStartElement(std::string_view name) {
+  void writeArrayStartElement(const auto& name) {
     this->writeObjStartElement(name);
   }
 
@@ -48,7 +61,7 @@ struct QtStreamWriter {
     this->writeObjEndElement();
   }
 
-  void writeEntryStartElement(std::string_view name) {
+  void writeEntryStartElement(const auto& name) {
     this->writeObjStartElement(name);
   }
 
@@ -56,8 +69,8 @@ struct QtStreamWriter {
     this->writeObjEndElement();
   }
 
-  void writeAttr(std::string_view name, const auto& value) {
-    _writer->writeAttribute(QString(name.data()), this->qstringValue(value));
+  void writeAttr(const auto& name, const auto& value) {
+    _writer->writeAttribute(qtName(name), this->qstringValue(value));
   }
 
   void writeAttrStartElement() {}
@@ -69,12 +82,18 @@ struct QtStreamWriter {
     return QString::number(value);
   }
 
+  QString qstringValue(std::floating_point auto value) const {
+    char buffer[32];
+    const auto [end, _] = std::to_chars(std::begin(buffer), std::end(buffer), value);
+    return QString::fromLatin1(buffer, static_cast<int>(end - buffer));
+  }
+
   QString qstringValue(bool value) const {
     return value ? "True" : "False";
   }
 
-  QString qstringValue(const std::string& value) const {
-    return QString(value.data());
+  QString qstringValue(std::string_view value) const {
+    return QString::fromUtf8(value.data(), static_cast<int>(value.size()));
   }
 
  private:
@@ -85,14 +104,16 @@ struct QtStreamReader {
   explicit QtStreamReader(std::shared_ptr<QXmlStreamReader> reader)
     : _reader(std::move(reader)) {}
 
-  [[nodiscard]] std::pair<std::string, bool> nextEntryName() const {
+  // The returned view is valid until the next entry name is read
+  [[nodiscard]] std::pair<std::string_view, bool> nextEntryName() const {
     const auto [nameRef, reached] = this->nextStartElement();
     if (!reached) {
       return { {}, false };
     }
 
-    auto name = nameRef.toString().toStdString();
-    return { std::move(name), true };
+    _name.clear();
+    this->appendStdString(_name, nameRef);
+    return { _name, true };
   }
 
   bool nextArrayEntry() const {
@@ -100,22 +121,43 @@ struct QtStreamReader {
     return reached;
   }
 
-  bool value(auto& value) const {
-    const auto input = _reader->readElementText();
+  // Skip the rest of the element returned by the last nextEntryName()
+  bool skipEntry() const {
+    _reader->skipCurrentElement();
+    return !_reader->hasError();
+  }
 
-    this->setValue(value, input);
-    return true;
+  std::errc value(auto& value) const {
+    if (!this->readText()) {
+      return std::errc::invalid_argument;
+    }
+    return Detail::parseValue(_text, value);
   }
 
-  bool attrValue(std::string_view name, auto& value) const {
-    auto attrs = _reader->attributes();
-    if (!attrs.hasAttribute(QString(name.data()))) {
-      return false;
+  std::errc attrValue(const auto& name, auto& value) const {
+    const auto& attrName = qtName(name);
+    const auto attrs = _reader->attributes();
+    if (!attrs.hasAttribute(attrName)) {
+      return {};
     }
 
-    auto input = attrs.value(QString(name.data()));
-    this->setValue(value, input.toString());
-    return true;
+    _text.clear();
+    this->appendStdString(_text, attrs.value(attrName));
+    return Detail::parseValue(_text, value);
+  }
+
+  template<typename Visitor>
+  void readAttrs(Visitor&& visitor) const {
+    const auto attrs = _reader->attributes();
+    for (const auto& attr : attrs) {
+      _attrName.clear();
+      this->appendStdString(_attrName, attr.name());
+      visitor(std::string_view(_attrName), [this, &attr](auto& value) {
+        _text.clear();
+        this->appendStdString(_text, attr.value());
+        return Detail::parseValue(_text, value);
+      });
+    }
   }
 
  private:
@@ -125,20 +167,43 @@ struct QtStreamReader {
     return { reached ? _reader->name() : QStringRef{}, reached };
   }
 
-  void setValue(std::integral auto& value, const QString& input) const {
-    value = input.toInt();
-  }
-
-  void setValue(bool& value, const QString& input) const {
-    value = input.compare("True", Qt::CaseInsensitive) == 0;
+  // Read the text of the current element, character tokens are only valid until the next
+  // token is read so they are converted right away
+  bool readText() const {
+    _text.clear();
+    for (auto token = _reader->readNext(); token != QXmlStreamReader::EndElement;
+         token = _reader->readNext()) {
+      switch (token) {
+      case QXmlStreamReader::Characters: this->appendStdString(_text, _reader->text()); break;
+      case QXmlStreamReader::Comment:
+      case QXmlStreamReader::ProcessingInstruction: break;
+      default: return false;
+      }
+    }
+    return true;
   }
 
-  void setValue(std::string& value, const QString& input) const {
-    value = input.toStdString();
+  // Append to an existing string, reusing its capacity for ASCII input
+  static void appendStdString(std::string& out, const QStringRef& input) {
+    const auto offset = out.size();
+    out.resize(offset + input.size());
+    for (int i = 0; i < input.size(); ++i) {
+      const auto c = input.at(i).unicode();
+      if (c >= 0x80) {
+        const auto utf8 = input.toUtf8();
+        out.resize(offset);
+        out.append(utf8.constData(), utf8.size());
+        return;
+      }
+      out[offset + i] = static_cast<char>(c);
+    }
   }
 
  private:
   std::shared_ptr<QXmlStreamReader> _reader;
+  mutable std::string _name;
+  mutable std::string _text;
+  mutable std::string _attrName;
 };
 
 #endif // !CPPDICT_SERIALIZER_QT_XML_HPP
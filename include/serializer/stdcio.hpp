@@ -1,17 +1,25 @@
 #ifndef CPPDICT_SERIALIZER_STDCIO_HPP
 #define CPPDICT_SERIALIZER_STDCIO_HPP
 
+#include <algorithm>
+#include <charconv>
 #include <concepts>
+#include <cstddef>
+#include <cstdio>
 #include <ios>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 
 #include "concepts.hpp"
+#include "parse.hpp"
 #include "serializer.hpp"
 
-std::string readInput(std::string_view prefix) {
+inline std::string readInput(std::string_view prefix) {
   std::string input;
   std::cout << prefix;
   std::cin >> input;
@@ -48,7 +56,11 @@ struct StdCout {
 
   template<typename T>
   void writeValue(const T& value) {
-    std::cout << _indent << value << std::endl;
+    if constexpr (Detail::StringLike<T>) {
+      std::cout << _indent << std::string_view(value) << std::endl;
+    } else {
+      std::cout << _indent << value << std::endl;
+    }
   }
 
   void writeObjStartElement(std::string_view name) {
@@ -100,10 +112,275 @@ struct StdCout {
   std::string _indent;
 };
 
+// Appends to a caller supplied, growable buffer
+struct StringSink {
+  explicit StringSink(std::shared_ptr<std::string> buffer)
+    : _buffer(std::move(buffer)) {}
+
+  void append(std::string_view data) {
+    _buffer->append(data);
+  }
+
+  void flush() {}
+
+  // Sink over a new buffer
+  StringSink fork() const {
+    return StringSink(std::make_shared<std::string>());
+  }
+
+  std::string_view view() const {
+    return *_buffer;
+  }
+
+ private:
+  std::shared_ptr<std::string> _buffer;
+};
+
+// Writes to a FILE* through a large block buffer, copies share the same buffer.
+// The buffer is written when full, and flushed down to the file on demand and when the
+// last copy is destroyed.
+struct FileSink {
+  static constexpr std::size_t BlockSize = 1 << 16;
+
+  explicit FileSink(std::FILE* file)
+    : _block(std::make_shared<Block>(file)) {}
+
+  void append(std::string_view data) {
+    _block->append(data);
+  }
+
+  void flush() {
+    _block->flush();
+  }
+
+  // First error met writing to the file, std::errc{} if none
+  std::errc error() const {
+    return _block->error;
+  }
+
+ private:
+  struct Block {
+    explicit Block(std::FILE* file)
+      : file(file) {}
+
+    Block(const Block&) = delete;
+    Block& operator=(const Block&) = delete;
+
+    ~Block() {
+      this->flush();
+    }
+
+    void append(std::string_view data) {
+      if (data.size() > BlockSize - size) {
+        this->write();
+        if (data.size() >= BlockSize) {
+          this->write(data);
+          return;
+        }
+      }
+      data.copy(buffer.get() + size, data.size());
+      size += data.size();
+    }
+
+    void flush() {
+      this->write();
+      if (std::fflush(file) != 0) {
+        this->report();
+      }
+    }
+
+    void write() {
+      this->write({ buffer.get(), size });
+      size = 0;
+    }
+
+    void write(std::string_view data) {
+      if (!data.empty() && std::fwrite(data.data(), 1, data.size(), file) != data.size()) {
+        this->report();
+      }
+    }
+
+    void report() {
+      if (error == std::errc{}) {
+        error = std::errc::io_error;
+      }
+    }
+
+    std::FILE* file;
+    std::unique_ptr<char[]> buffer{ new char[BlockSize] };
+    std::size_t size{};
+    std::errc error{};
+  };
+
+  std::shared_ptr<Block> _block;
+};
+
+// StdCout output format without per line flushes or iostream formatting
+template<typename Sink>
+struct StdBufferedWriter {
+  explicit StdBufferedWriter(Sink sink)
+    : _sink(std::move(sink)) {}
+
+ public:
+  void write(std::string_view name, std::integral auto value) {
+    this->line(name, " (integral) : ", value);
+  }
+
+  void write(std::string_view name, bool value) {
+    this->line(name, " (bool) : ", value ? "true" : "false");
+  }
+
+  void write(std::string_view name, const std::string& value) {
+    this->line(name, " (string) : ", "\"", value, "\"");
+  }
+
+  void write(std::string_view name, const Unspecified auto& value) {
+    this->line(name, " (T) : ", value);
+  }
+
+  void write(std::string_view name) {
+    this->line(name, " (void)");
+  }
+
+  void writeValue(const auto& value) {
+    this->indent();
+    this->append(value, "\n");
+  }
+
+  void writeObjStartElement(std::string_view name) {
+    this->line(name, " : {");
+    _indent += 2;
+  }
+
+  void writeObjEndElement() {
+    _indent -= 2;
+    this->indent();
+    this->append("}\n");
+  }
+
+  void writeArrayStartElement(std::string_view name) {
+    this->line(name, " : [");
+    _indent += 2;
+  }
+
+  void writeArrayEndElement() {
+    _indent -= 2;
+    this->indent();
+    this->append("]\n");
+  }
+
+  void writeEntryStartElement(std::string_view name) {
+    this->writeObjStartElement(name);
+  }
+
+  void writeEntryEndElement() {
+    this->writeObjEndElement();
+  }
+
+  void writeAttr(std::string_view name, const auto& value) {
+    this->append("'", name, "': ", value);
+  }
+
+  void writeAttrStartElement() {
+    this->indent();
+    this->append("  -> ATTRS: [ ");
+  }
+
+  void writeAttrEndElement() {
+    this->append(" ]\n");
+  }
+
+  // Writer continuing at the current indentation, over a sink of its own
+  StdBufferedWriter fork() const requires requires(const Sink& sink) { sink.fork(); } {
+    StdBufferedWriter part(_sink.fork());
+    part._indent = _indent;
+    return part;
+  }
+
+  void splice(const StdBufferedWriter& part) requires requires { part._sink.view(); } {
+    _sink.append(part._sink.view());
+  }
+
+  void flush() {
+    _sink.flush();
+  }
+
+ private:
+  static constexpr std::string_view Spaces = "                                ";
+
+  template<typename... Values>
+  void line(std::string_view name, const Values&... values) {
+    this->indent();
+    this->append("'", name, "'", values..., "\n");
+  }
+
+  void indent() {
+    for (auto indent = _indent; indent > 0; indent -= std::min(indent, Spaces.size())) {
+      _sink.append(Spaces.substr(0, std::min(indent, Spaces.size())));
+    }
+  }
+
+  template<typename... Values>
+  void append(const Values&... values) {
+    (this->appendValue(values), ...);
+  }
+
+  void appendValue(std::string_view value) {
+    _sink.append(value);
+  }
+
+  void appendValue(const char* value) {
+    _sink.append(value);
+  }
+
+  void appendValue(const std::string& value) {
+    _sink.append(value);
+  }
+
+  void appendValue(bool value) {
+    _sink.append(value ? "1" : "0");
+  }
+
+  // Characters are written as such, as std::cout prints them
+  template<std::integral T>
+  void appendValue(T value) {
+    if constexpr (Detail::IsAnyOf<T, char, signed char, unsigned char>) {
+      const char character = static_cast<char>(value);
+      _sink.append({ &character, 1 });
+    } else {
+      char buffer[32];
+      const auto [end, _] = std::to_chars(std::begin(buffer), std::end(buffer), value);
+      _sink.append({ buffer, static_cast<std::size_t>(end - buffer) });
+    }
+  }
+
+  // 6 significant digits, as std::cout prints them by default
+  void appendValue(std::floating_point auto value) {
+    char buffer[32];
+    const auto [end, _] = std::to_chars(
+      std::begin(buffer), std::end(buffer), value, std::chars_format::general, 6);
+    _sink.append({ buffer, static_cast<std::size_t>(end - buffer) });
+  }
+
+  // Other values are formatted by their operator<<, as StdCout does
+  template<typename T>
+  requires Unspecified<T> && (!std::floating_point<T>) &&
+    (!std::convertible_to<const T&, std::string_view>)
+  void appendValue(const T& value) {
+    std::ostringstream out;
+    out << value;
+    _sink.append(out.view());
+  }
+
+ private:
+  Sink _sink;
+  std::size_t _indent{};
+};
+
 struct StdCin {
   static constexpr std::string_view prefix = "value: ";
 
-  [[nodiscard]] std::pair<std::string, bool> nextEntryName() const {
+  [[nodiscard]] std::pair<std::string_view, bool> nextEntryName() const {
     std::cout << "Entry name: ";
     return this->nextInput();
   }
@@ -114,49 +391,37 @@ struct StdCin {
     return valid;
   }
 
-  bool value(auto& value) const {
+  std::errc value(auto& value) const {
     std::cout << "Value: ";
     const auto& [input, valid] = this->nextInput();
     if (!valid) {
-      return false;
+      return {};
     }
 
-    this->setValue(value, input);
-    return true;
+    return Detail::parseValue(input, value);
   }
 
-  bool attrValue(std::string_view name, auto& value) const {
+  std::errc attrValue(std::string_view name, auto& value) const {
     std::cout << "Attr '" << name << "': ";
     const auto& [inputValue, valid] = this->nextInput();
     if (!valid) {
-      return false;
+      return {};
     }
 
-    this->setValue(value, inputValue);
-    return true;
+    return Detail::parseValue(inputValue, value);
   }
 
  private:
-  [[nodiscard]] std::pair<std::string, bool> nextInput() const {
-    std::string str;
-
-    std::cin >> str;
-    const bool noValue = std::cin.eof() || str == "-";
+  // The returned view is valid until the next input is read
+  [[nodiscard]] std::pair<std::string_view, bool> nextInput() const {
+    std::cin >> _input;
+    const bool noValue = std::cin.eof() || _input == "-";
 
-    return { std::move(str), !noValue };
-  }
-  
-  void setValue(std::integral auto& value, const std::string& input) const {
-    value = std::stoi(input);
+    return { _input, !noValue };
   }
 
-  void setValue(bool& value, const std::string& input) const {
-    value = input == "True";
-  }
-
-  void setValue(std::string& value, const std::string& input) const {
-    value = input;
-  }
+ private:
+  mutable std::string _input;
 };
 
 #endif // !CPPDICT_SERIALIZER_STDCIO_HPP
@@ -40,4 +40,15 @@ struct StringLiteral {
 template<unsigned N>
 StringLiteral(const char (&)[N]) -> StringLiteral<N - 1>;
 
+// Name known at compile time, handed to backends so they can prepare it once per name.
+// Backends which don't care take it as a std::string_view.
+template<StringLiteral Name>
+struct NameTag {
+  static constexpr std::string_view value = Name;
+
+  constexpr operator std::string_view() const {
+    return value;
+  }
+};
+
 #endif // !CPPDICT_STRING_LITERAL_HPP
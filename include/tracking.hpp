@@ -0,0 +1,69 @@
+#ifndef CPPDICT_TRACKING_HPP
+#define CPPDICT_TRACKING_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <tuple>
+
+namespace Detail {
+
+  inline std::atomic<std::uint64_t> versionClock{ 0 };
+
+} // namespace Detail
+
+// Change tracking tag given to makeEntry next to the entry's attributes,
+// e.g. makeEntry<"Int">(5, Tracked{}). Mutable access to the entry through get<Path>()
+// and decoding it stamp the entry with a new version, Serializer::serializeDelta()
+// only writing the entries stamped after a given version. get<Path>() on a const tree
+// only reads, leaving the entry unstamped.
+class Tracked {
+ public:
+  // Latest version handed out, changes made from now on are stamped with greater ones
+  static std::uint64_t now() {
+    return Detail::versionClock.load(std::memory_order_relaxed);
+  }
+
+  std::uint64_t version() const {
+    return _version;
+  }
+
+  void touch() {
+    _version = Detail::versionClock.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+ private:
+  std::uint64_t _version{};
+};
+
+namespace Detail {
+
+  constexpr void touchTag(const auto&) {}
+
+  inline void touchTag(Tracked& tag) {
+    tag.touch();
+  }
+
+  constexpr std::uint64_t versionOf(const auto&) {
+    return 0;
+  }
+
+  inline std::uint64_t versionOf(const Tracked& tag) {
+    return tag.version();
+  }
+
+  // Stamp an entry holding a Tracked tag among its attributes as changed
+  template<typename Attrs>
+  constexpr void touch(Attrs& attrs) {
+    std::apply([](auto&... tags) { (touchTag(tags), ...); }, attrs);
+  }
+
+  // Whether an entry's Tracked tag was stamped after version since
+  template<typename Attrs>
+  bool touchedSince(const Attrs& attrs, std::uint64_t since) {
+    return std::apply(
+      [since](const auto&... tags) { return ((versionOf(tags) > since) || ...); }, attrs);
+  }
+
+} // namespace Detail
+
+#endif // !CPPDICT_TRACKING_HPP
@@ -0,0 +1,93 @@
+#ifndef CPPDICT_VERSIONING_HPP
+#define CPPDICT_VERSIONING_HPP
+
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+// Schema version tags given to makeEntry next to the entry's attributes, e.g.
+// makeEntry<"Port">(8080, Since<2>{}) for an entry added by version 2 of a schema, or
+// Deprecated<3>{} for one dropped by version 3. A Serializer writing an older version
+// (SerializerOptions::version) leaves out the entries that version doesn't have.
+template<std::uint32_t Version>
+struct Since {
+  static constexpr std::uint32_t version = Version;
+};
+
+template<std::uint32_t Version>
+struct Deprecated {
+  static constexpr std::uint32_t version = Version;
+};
+
+// Value given to an entry the input lacks, e.g. makeEntry<"Port">(ref(port), Default{ 80 })
+// for input written before the entry existed. Entries without it keep their value.
+template<typename T>
+struct Default {
+  T value;
+};
+
+namespace Detail {
+
+  inline constexpr std::uint32_t LatestVersion = std::numeric_limits<std::uint32_t>::max();
+
+  constexpr bool inVersion(const auto&, std::uint32_t) {
+    return true;
+  }
+
+  template<std::uint32_t Version>
+  constexpr bool inVersion(const Since<Version>&, std::uint32_t version) {
+    return Version <= version;
+  }
+
+  template<std::uint32_t Version>
+  constexpr bool inVersion(const Deprecated<Version>&, std::uint32_t version) {
+    return version < Version;
+  }
+
+  // Whether an entry holding attrs is part of the given schema version
+  template<typename Attrs>
+  constexpr bool entryInVersion(const Attrs& attrs, std::uint32_t version) {
+    return std::apply(
+      [version](const auto&... tags) { return (inVersion(tags, version) && ...); }, attrs);
+  }
+
+  template<typename T>
+  constexpr bool IsDeprecated = false;
+
+  template<std::uint32_t Version>
+  constexpr bool IsDeprecated<Deprecated<Version>> = true;
+
+  template<typename T>
+  constexpr bool IsDefault = false;
+
+  template<typename T>
+  constexpr bool IsDefault<Default<T>> = true;
+
+  template<typename Attrs>
+  constexpr bool HasDefault = false;
+
+  template<typename... Attrs>
+  constexpr bool HasDefault<std::tuple<Attrs...>> =
+    (IsDefault<std::remove_cvref_t<Attrs>> || ...);
+
+  // Entries holding a Default tag among their attributes
+  template<typename T>
+  concept DefaultedEntry = requires { requires HasDefault<decltype(T::attrs)>; };
+
+  constexpr void assignDefault(auto&, const auto&) {}
+
+  template<typename Value, typename T>
+  constexpr void assignDefault(Value& value, const Default<T>& tag) {
+    value = tag.value;
+  }
+
+  // Assign the Default tag found among an entry's attrs to its value
+  template<typename Value, typename Attrs>
+  constexpr void applyDefault(Value& value, const Attrs& attrs) {
+    std::apply([&value](const auto&... tags) { (assignDefault(value, tags), ...); }, attrs);
+  }
+
+} // namespace Detail
+
+#endif // !CPPDICT_VERSIONING_HPP
@@ -0,0 +1,577 @@
+#include "./data.hpp"
+
+#include "deserializer.hpp"
+#include "encoding.hpp"
+#include "fixed.hpp"
+#include "lazy.hpp"
+#include "serializer.hpp"
+#include "serializer/binary.hpp"
+#include "tracking.hpp"
+#include "versioning.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+void dump(const std::string& buffer) {
+  for (std::size_t i = 0; i < buffer.size(); ++i) {
+    std::printf("%02x%c", static_cast<unsigned char>(buffer[i]), (i + 1) % 16 ? ' ' : '\n');
+  }
+  std::printf("\n");
+}
+
+int failures = 0;
+
+void expect(bool condition, const char* what) {
+  if (!condition) {
+    std::cout << "FAILED: " << what << std::endl;
+    ++failures;
+  }
+}
+
+// Entry "Fieldnn" holding nn
+template<std::size_t I>
+constexpr StringLiteral<7> fieldName() {
+  const char name[] = { 'F', 'i', 'e', 'l', 'd', static_cast<char>('0' + I / 10),
+                        static_cast<char>('0' + I % 10) };
+  return StringLiteral<7>(name);
+}
+
+template<std::size_t... Is>
+auto makeWide(std::index_sequence<Is...>) {
+  return makeEntry<"Wide">(std::tuple{ makeEntry<fieldName<Is>()>(static_cast<int>(Is))... });
+}
+
+// values written with the given encoding, then read back into a vector of Out
+template<typename Out, typename In, typename Encoding>
+std::vector<Out> encodeRoundTrip(const std::vector<In>& values, Encoding encoding) {
+  auto buffer = std::make_shared<std::string>();
+  Serializer serializer(BinaryWriter{ buffer });
+  serializer.serialize(makeEntry<"Values">(std::cref(values), encoding));
+  std::vector<Out> decoded;
+  Deserializer deserializer(BinaryReader{ *buffer });
+  deserializer.deserialize(makeEntry<"Values">(std::ref(decoded)));
+  return decoded;
+}
+
+// Edge values round tripped with encoding, as themselves and widened to 64 bits
+template<typename Encoding>
+bool encodesEdgeValues(Encoding encoding) {
+  using Limits = std::numeric_limits<std::int64_t>;
+  const std::vector<std::vector<std::int64_t>> cases{
+    {},
+    { 42 },
+    { 0, 1, 1, 0 },
+    { 0, 255, 128, 1 },
+    { Limits::min(), Limits::max(), 0, Limits::min() },
+    { Limits::max(), Limits::max() },
+  };
+  const bool same = std::ranges::all_of(cases, [encoding](const auto& values) {
+    return encodeRoundTrip<std::int64_t>(values, encoding) == values;
+  });
+
+  const std::vector<std::int32_t> narrow{ std::numeric_limits<std::int32_t>::min(), -1, 0,
+                                          std::numeric_limits<std::int32_t>::max() };
+  const auto widened = encodeRoundTrip<std::int64_t>(narrow, encoding);
+  return same && std::ranges::equal(widened, narrow);
+}
+
+// make_data() with its leaves tracked for delta serialization
+auto make_tracked_data() {
+  return makeEntry<"Root">(
+    std::tuple{
+      makeEntry<"Int">(5, makeAttr<"ENABLE">(true), Tracked{}),
+      makeEntry<"Str">("Test", Tracked{}),
+      makeEntry<"Data">(Data{}, Tracked{}),
+      makeEntry<"Vec">(std::vector<int>{}, Tracked{}),
+      makeEntry<"Child">(std::tuple{
+        makeEntry<"Bool">(true, makeAttr<"TEST">(15), Tracked{}),
+      }),
+    },
+    makeAttr<"IsRoot">(true));
+}
+
+// Record stored column by column, its label is long enough to live on the heap
+class Sample {
+ public:
+  static constexpr auto EntryName = "Sample";
+
+  Sample() = default;
+
+  Sample(int id, std::string label)
+    : _id(id)
+    , _label(std::move(label)) {}
+
+  void serialize(auto& serializer) const {
+    using std::cref;
+    serializer.serialize(makeEntry<"Id">(cref(_id)), //
+                         makeEntry<"Label">(cref(_label)));
+  }
+
+  void deserialize(auto& deserializer) {
+    using std::ref;
+    deserializer.deserialize(makeEntry<"Id">(ref(_id)), //
+                             makeEntry<"Label">(ref(_label)));
+  }
+
+  bool operator==(const Sample&) const = default;
+
+  const std::string& label() const {
+    return _label;
+  }
+
+ private:
+  int _id{};
+  std::string _label;
+};
+
+// Record with a collection field, which can't be stored in a column
+class Series {
+ public:
+  static constexpr auto EntryName = "Series";
+
+  Series() = default;
+
+  explicit Series(std::vector<int> points)
+    : _points(std::move(points)) {}
+
+  void serialize(auto& serializer) const {
+    using std::cref;
+    serializer.serialize(makeEntry<"Points">(cref(_points)));
+  }
+
+  void deserialize(auto& deserializer) {
+    using std::ref;
+    deserializer.deserialize(makeEntry<"Points">(ref(_points)));
+  }
+
+  bool operator==(const Series&) const = default;
+
+ private:
+  std::vector<int> _points;
+};
+
+std::vector<Sample> makeSamples(std::size_t size) {
+  std::vector<Sample> samples;
+  for (std::size_t i = 0; i < size; ++i) {
+    samples.emplace_back(static_cast<int>(i),
+                         "a label past the inline buffer " + std::to_string(i));
+  }
+  return samples;
+}
+
+// Settings at version 2 of their schema, which dropped Old and added Port
+auto makeSettings(int old, int port, int tail) {
+  return makeEntry<"Settings">(std::tuple{
+    makeEntry<"Old">(old, Deprecated<2>{}),
+    makeEntry<"Port">(port, Since<2>{}, Default{ 80 }, Tracked{}),
+    makeEntry<"Tail">(tail, Tracked{}),
+  });
+}
+
+class Reading {
+ public:
+  static constexpr auto EntryName = "Reading";
+
+  void serialize(auto& serializer) const {
+    using std::cref;
+    serializer.serialize(makeEntry<"Value">(cref(_value)), //
+                         makeEntry<"Unit">(cref(_unit), Since<2>{}));
+  }
+
+ private:
+  int _value{ 7 };
+  std::string _unit{ "ms" };
+};
+
+// Record writing only its even values, through a view of unknown size
+class Group {
+ public:
+  static constexpr auto EntryName = "Group";
+
+  Group() = default;
+
+  explicit Group(std::vector<int> values)
+    : _values(std::move(values)) {}
+
+  void serialize(auto& serializer) const {
+    const auto even = [](int value) { return value % 2 == 0; };
+    serializer.serialize(makeEntry<"Values">(_values | std::views::filter(even)));
+  }
+
+  void deserialize(auto& deserializer) {
+    deserializer.deserialize(makeEntry<"Values">(std::ref(_values)));
+  }
+
+  const std::vector<int>& values() const {
+    return _values;
+  }
+
+  bool operator==(const Group&) const = default;
+
+ private:
+  std::vector<int> _values;
+};
+
+// Writing threads seen at once by Busy records
+std::atomic<int> busyThreads{};
+std::atomic<int> mostBusyThreads{};
+
+// Record taking a while to write, counting the threads writing one concurrently
+class Busy {
+ public:
+  static constexpr auto EntryName = "Busy";
+
+  void serialize(auto& serializer) const {
+    const auto busy = ++busyThreads;
+    for (auto most = mostBusyThreads.load(); most < busy;) {
+      mostBusyThreads.compare_exchange_weak(most, busy);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    --busyThreads;
+    serializer.serialize(makeEntry<"Id">(std::cref(_id)));
+  }
+
+ private:
+  int _id{ 1 };
+};
+
+// Record holding a collection large enough to be split across threads itself
+class Batch {
+ public:
+  static constexpr auto EntryName = "Batch";
+
+  void serialize(auto& serializer) const {
+    serializer.serialize(makeEntry<"Items">(std::cref(_items)));
+  }
+
+ private:
+  std::vector<Busy> _items{ std::vector<Busy>(4) };
+};
+
+int main(void) {
+  auto buffer = std::make_shared<std::string>();
+
+  Serializer serializer(BinaryWriter{ buffer });
+
+  auto tree = make_data();
+
+  std::cout << "[binary] Serialization: " << std::endl;
+  serializer.serialize(tree);
+  const auto encoded = *buffer;
+  std::cout << encoded.size() << " bytes" << std::endl;
+  dump(encoded);
+
+  std::cout << '\n' << "[binary] Deserialization" << std::endl;
+  Deserializer deserializer(BinaryReader{ encoded });
+  deserializer.deserialize(tree);
+
+  std::cout << '\n' << "[binary] Serialization:" << std::endl;
+  buffer->clear();
+  serializer.serialize(tree);
+  std::cout << (*buffer == encoded ? "identical" : "different") << " round trip" << std::endl;
+  expect(*buffer == encoded, "identical round trip");
+
+  std::cout << '\n' << "[binary] Partial deserialization" << std::endl;
+  auto partial = make_data();
+  Deserializer pathDeserializer(BinaryReader{ encoded });
+  const bool found = pathDeserializer.deserializePath<"Root/Child/Bool">(partial);
+  std::cout << "Root/Child/Bool " << (found ? "found" : "missing") << std::endl;
+  expect(found, "Root/Child/Bool found");
+
+  std::cout << '\n' << "[binary] Delta serialization" << std::endl;
+  auto tracked = make_tracked_data();
+  const auto since = Tracked::now();
+  tracked.get<"Root/Child/Bool">() = false;
+  const auto& readOnly = std::as_const(tracked);
+  const bool read = readOnly.get<"Root/Int">() == 5 && readOnly.get<"Root/Str">() == "Test" &&
+                    readOnly.get<"Root/Int/@ENABLE">();
+  buffer->clear();
+  serializer.serializeDelta(tracked, since);
+  const auto delta = *buffer;
+  expect(read && delta.find("Int") == delta.npos && delta.find("Str") == delta.npos,
+         "entries only read left out of the delta");
+  std::cout << delta.size() << " bytes" << std::endl;
+  dump(delta);
+  Deserializer patchDeserializer(BinaryReader{ delta }, DeserializerOptions{ .patch = true });
+  patchDeserializer.deserialize(partial);
+  std::cout << "Root/Child/Bool patched to " << partial.get<"Root/Child/Bool">() << std::endl;
+  expect(!partial.get<"Root/Child/Bool">(), "Root/Child/Bool patched");
+
+  std::cout << '\n' << "[binary] Integer encodings" << std::endl;
+  expect(encodesEdgeValues(DeltaEncoding{}), "delta encoded edge values");
+  expect(encodesEdgeValues(PackedEncoding{}), "packed encoded edge values");
+
+  std::cout << '\n' << "[binary] Fixed capacity" << std::endl;
+  const auto overflows = [](auto grow) {
+    try {
+      grow();
+    } catch (const std::length_error&) {
+      return true;
+    }
+    return false;
+  };
+  StaticVector<int, 3> three{ 1, 2, 3 };
+  expect(overflows([&three] { three.push_back(4); }) && three.size() == 3,
+         "full StaticVector not grown");
+  expect(overflows([] { StaticVector<int, 3>{ 1, 2, 3, 4 }; }),
+         "StaticVector not built from too many items");
+  buffer->clear();
+  serializer.serialize(makeEntry<"Values">(std::vector<int>{ 1, 2, 3, 4 }));
+  Deserializer threeDeserializer(BinaryReader{ *buffer });
+  threeDeserializer.deserialize(makeEntry<"Values">(std::ref(three)));
+  expect(threeDeserializer.error() == std::errc::value_too_large,
+         "too many items for a StaticVector reported");
+
+  std::cout << '\n' << "[binary] Sized objects" << std::endl;
+  auto sized = std::make_shared<std::string>();
+  const BinaryWriterOptions sizedOptions{ .sizedObjects = true };
+  Serializer sizedSerializer(BinaryWriter{ sized, sizedOptions });
+  sizedSerializer.serialize(tree);
+  std::cout << sized->size() << " bytes" << std::endl;
+  auto older = makeEntry<"Root">(std::tuple{ makeEntry<"Int">(0) });
+  Deserializer olderDeserializer(BinaryReader{ *sized });
+  olderDeserializer.deserialize(older);
+  std::cout << olderDeserializer.stats().unknownEntries << " unknown entries skipped, "
+            << "Root/Int = " << older.get<"Root/Int">() << std::endl;
+  expect(older.get<"Root/Int">() == 5 && olderDeserializer.stats().unknownEntries == 4,
+         "sized objects skipped");
+  const auto dataVec = sized->find("DataVec") + std::string_view("DataVec").size();
+  expect(static_cast<Detail::BinaryTag>((*sized)[dataVec]) == Detail::BinaryTag::Sized,
+         "arrays sized as well");
+  auto sizedTree = make_data();
+  Deserializer sizedDeserializer(BinaryReader{ *sized });
+  sizedDeserializer.deserialize(sizedTree);
+  buffer->clear();
+  serializer.serialize(sizedTree);
+  expect(sizedDeserializer.error() == std::errc{} && *buffer == encoded &&
+           BinaryIndex(*sized).find("Root/Child/Bool") != BinaryIndex::npos,
+         "sized arrays decoded and indexed");
+  auto dataInt = makeEntry<"Root">(std::tuple{
+    makeEntry<"Data">(std::tuple{ makeEntry<"Int">(0) }),
+  });
+  Deserializer arraySkipper(BinaryReader{ *sized });
+  arraySkipper.deserialize(dataInt);
+  expect(dataInt.get<"Root/Data/Int">() == 42 && arraySkipper.error() == std::errc{},
+         "sized array skipped");
+
+  std::cout << '\n' << "[binary] Lazy deserialization" << std::endl;
+  const BinaryIndex index(encoded);
+  LazyTree lazy(make_data(), index);
+  std::cout << index.size() << " indexed entries, Root/Child/Bool/@TEST = "
+            << lazy.get<"Root/Child/Bool/@TEST">() << std::endl;
+  expect(lazy.get<"Root/Child/Bool/@TEST">() == 15, "Root/Child/Bool/@TEST decoded");
+  lazy.get<"Root/Child/Bool">() = false;
+  lazy.get<"Root/Child">();
+  expect(!lazy.get<"Root/Child/Bool">(), "Root/Child/Bool kept when Root/Child is decoded");
+  lazy.get<"Root/Int">() = 6;
+  expect(lazy.get<"Root/Int">() == 6, "Root/Int decoded once");
+  auto reset = make_data();
+  reset.get<"Root/Int">() = 0;
+  LazyTree other(std::move(reset), index);
+  expect(other.get<"Root/Int">() == 5, "Root/Int decoded again by another tree");
+
+  std::cout << '\n' << "[binary] Versioned schema" << std::endl;
+  buffer->clear();
+  serializer.serializeWithSchema(makeSettings(1, 8080, 3));
+  auto latest = makeSettings(0, 0, 0);
+  Deserializer latestDeserializer(BinaryReader{ *buffer });
+  latestDeserializer.deserialize(latest);
+  expect(latest.get<"Settings/Port">() == 8080 && latest.get<"Settings/Tail">() == 3,
+         "latest version decoded by position");
+
+  const std::string positional = *buffer;
+  const auto tail = positional.find("Tail");
+  const auto cut = positional.substr(0, tail - 1);
+  auto truncated = makeSettings(0, 0, 0);
+  Deserializer truncatedDeserializer(BinaryReader{ cut });
+  truncatedDeserializer.deserialize(truncated);
+  expect(truncatedDeserializer.error() == std::errc::invalid_argument &&
+           truncated.get<"Settings/Port">() == 8080,
+         "input ending before the last entry reported");
+
+#ifndef NDEBUG
+  auto renamed = positional;
+  renamed.replace(tail, 4, "Tale");
+  auto misnamed = makeSettings(0, 0, 0);
+  Deserializer misnamedDeserializer(BinaryReader{ renamed });
+  misnamedDeserializer.deserialize(misnamed);
+  expect(misnamedDeserializer.error() == std::errc::invalid_argument,
+         "entry met out of the schema's order reported");
+#endif
+
+  buffer->clear();
+  Serializer oldSerializer(BinaryWriter{ buffer }, SerializerOptions{ .version = 1 });
+  oldSerializer.serializeWithSchema(makeSettings(1, 8080, 3));
+  auto upgraded = makeSettings(0, 0, 0);
+  Deserializer upgradeDeserializer(BinaryReader{ *buffer });
+  upgradeDeserializer.deserialize(upgraded);
+  std::cout << "Version 1 read as Old = " << upgraded.get<"Settings/Old">()
+            << ", Port = " << upgraded.get<"Settings/Port">() << std::endl;
+  expect(upgraded.get<"Settings/Old">() == 1 && upgraded.get<"Settings/Port">() == 80 &&
+           upgraded.get<"Settings/Tail">() == 3,
+         "version 1 decoded with defaults");
+
+  auto settings = makeSettings(0, 8080, 3);
+  auto patched = settings;
+  const auto settingsSince = Tracked::now();
+  settings.get<"Settings/Tail">() = 4;
+  buffer->clear();
+  serializer.serializeDelta(settings, settingsSince);
+  Deserializer settingsPatch(BinaryReader{ *buffer }, DeserializerOptions{ .patch = true });
+  settingsPatch.deserialize(patched);
+  expect(patched.get<"Settings/Port">() == 8080 && patched.get<"Settings/Tail">() == 4,
+         "delta applied without defaults");
+
+  std::cout << '\n' << "[binary] Parallel serialization" << std::endl;
+  const std::vector<Reading> readings(256);
+  const auto readingsTree = makeEntry<"Readings">(std::tuple{
+    makeEntry<"First">(std::cref(readings)),
+    makeEntry<"Second">(std::cref(readings)),
+  });
+  buffer->clear();
+  oldSerializer.serialize(readingsTree);
+  auto parallel = std::make_shared<std::string>();
+  const SerializerOptions parallelOptions{
+    .threads = 4,
+    .parallelThreshold = 16,
+    .version = 1,
+  };
+  Serializer parallelSerializer(BinaryWriter{ parallel }, parallelOptions);
+  parallelSerializer.serialize(readingsTree);
+  std::cout << parallel->size() << " bytes, "
+            << (*parallel == *buffer ? "identical" : "different") << " to sequential"
+            << std::endl;
+  expect(*parallel == *buffer, "parallel output identical to sequential at version 1");
+
+  const std::vector<Batch> batches(8);
+  const SerializerOptions nestedOptions{ .threads = 4, .parallelThreshold = 2 };
+  buffer->clear();
+  serializer.serialize(makeEntry<"Batches">(std::cref(batches)));
+  parallel->clear();
+  Serializer nestedSerializer(BinaryWriter{ parallel }, nestedOptions);
+  nestedSerializer.serialize(makeEntry<"Batches">(std::cref(batches)));
+  expect(*parallel == *buffer && mostBusyThreads <= 4,
+         "nested collections written on at most 4 threads");
+
+  const std::vector<Reading> fewReadings(2);
+  buffer->clear();
+  serializer.serialize(makeEntry<"Readings">(std::cref(fewReadings)));
+  parallel->clear();
+  nestedSerializer.serialize(makeEntry<"Readings">(std::cref(fewReadings)));
+  expect(*parallel == *buffer, "fewer items than threads written in order");
+
+  std::cout << '\n' << "[binary] Columnar records" << std::endl;
+  const auto samples = makeSamples(8);
+  buffer->clear();
+  serializer.serialize(makeEntry<"Samples">(std::cref(samples), ColumnarEncoding{}));
+  std::cout << buffer->size() << " bytes" << std::endl;
+  std::vector<Sample> columns;
+  Deserializer columnsDeserializer(BinaryReader{ *buffer });
+  columnsDeserializer.deserialize(makeEntry<"Samples">(std::ref(columns)));
+  expect(columns == samples, "columnar records decoded");
+  std::vector<const char*> labels;
+  for (const auto& sample : columns) {
+    labels.push_back(sample.label().data());
+  }
+  const DeserializerOptions reuseOptions{ .collections = CollectionMode::Reuse };
+  Deserializer reuseDeserializer(BinaryReader{ *buffer }, reuseOptions);
+  reuseDeserializer.deserialize(makeEntry<"Samples">(std::ref(columns)));
+  const auto label = [](const Sample& sample) { return sample.label().data(); };
+  expect(columns == samples && std::ranges::equal(columns, labels, {}, label),
+         "columnar records decoded over the buffers of their fields");
+
+  const std::vector<Series> series{ Series({ 1, 2 }), Series({ 3 }) };
+  buffer->clear();
+  serializer.serialize(makeEntry<"Series">(std::cref(series), ColumnarEncoding{}));
+  std::vector<Series> rows;
+  Deserializer rowsDeserializer(BinaryReader{ *buffer });
+  rowsDeserializer.deserialize(makeEntry<"Series">(std::ref(rows)));
+  expect(rows == series, "records with collection fields written row by row");
+
+  buffer->clear();
+  serializer.serialize(makeEntry<"Samples">(std::cref(samples), ColumnarEncoding{}),
+                       makeEntry<"After">(7));
+  std::vector<int> mismatched;
+  int after = 0;
+  Deserializer mismatchDeserializer(BinaryReader{ *buffer });
+  mismatchDeserializer.deserialize(makeEntry<"Samples">(std::ref(mismatched)),
+                                   makeEntry<"After">(std::ref(after)));
+  expect(mismatchDeserializer.error() == std::errc::invalid_argument && after == 7,
+         "columns skipped when decoded into other items");
+
+  std::cout << '\n' << "[binary] Memory resource" << std::endl;
+  const std::vector<std::string> names{ "a name past the inline buffer of strings",
+                                        "another name past the inline buffer" };
+  buffer->clear();
+  serializer.serialize(makeEntry<"Names">(std::cref(names)));
+  std::pmr::monotonic_buffer_resource arena;
+  std::vector<std::pmr::string> arenaNames;
+  const DeserializerOptions arenaOptions{ .resource = &arena };
+  Deserializer arenaDeserializer(BinaryReader{ *buffer }, arenaOptions);
+  arenaDeserializer.deserialize(makeEntry<"Names">(std::ref(arenaNames)));
+  const auto fromArena = [&arena](const std::pmr::string& name) {
+    return name.get_allocator().resource() == &arena;
+  };
+  const auto same = [](std::string_view lhs, std::string_view rhs) { return lhs == rhs; };
+  expect(std::ranges::equal(arenaNames, names, same) &&
+           std::ranges::all_of(arenaNames, fromArena),
+         "new items allocated from the resource");
+
+  std::cout << '\n' << "[binary] Parallel deserialization" << std::endl;
+  const std::vector<std::string> manyNames(256, names.front());
+  buffer->clear();
+  serializer.serialize(makeEntry<"Names">(std::cref(manyNames)));
+  const DeserializerOptions parallelDecode{ .threads = 4, .parallelThreshold = 16 };
+  std::vector<std::string> parallelNames;
+  Deserializer parallelDeserializer(BinaryReader{ *buffer }, parallelDecode);
+  parallelDeserializer.deserialize(makeEntry<"Names">(std::ref(parallelNames)));
+  expect(parallelNames == manyNames, "array decoded on several threads");
+
+  // The arena isn't synchronized, the strings allocating from it are decoded on this thread
+  std::pmr::monotonic_buffer_resource namesArena;
+  std::pmr::vector<std::pmr::string> pmrNames(&namesArena);
+  Deserializer pmrDeserializer(BinaryReader{ *buffer }, parallelDecode);
+  pmrDeserializer.deserialize(makeEntry<"Names">(std::ref(pmrNames)));
+  expect(std::ranges::equal(pmrNames, manyNames, same), "std::pmr array decoded with threads");
+
+  std::cout << '\n' << "[binary] Unsized arrays" << std::endl;
+  const std::vector<Group> groups{ Group({ 1, 2, 3, 4 }), Group(), Group({ 5, 6, 8 }) };
+  const auto nonEmpty = [](const Group& group) { return !group.values().empty(); };
+  buffer->clear();
+  serializer.serialize(makeEntry<"Groups">(groups | std::views::filter(nonEmpty)));
+  std::vector<Group> evenGroups;
+  Deserializer unsizedDeserializer(BinaryReader{ *buffer });
+  unsizedDeserializer.deserialize(makeEntry<"Groups">(std::ref(evenGroups)));
+  const std::vector<Group> expected{ Group({ 2, 4 }), Group({ 6, 8 }) };
+  expect(unsizedDeserializer.error() == std::errc{} && evenGroups == expected,
+         "nested filtered arrays decoded");
+
+  std::cout << '\n' << "[binary] Wide schema" << std::endl;
+  auto wide = makeWide(std::make_index_sequence<84>{});
+  buffer->clear();
+  serializer.serialize(wide);
+  auto wideCopy = wide;
+  wideCopy.get<"Wide/Field00">() = -1;
+  wideCopy.get<"Wide/Field83">() = -1;
+  Deserializer wideDeserializer(BinaryReader{ *buffer });
+  wideDeserializer.deserialize(wideCopy);
+  expect(wideCopy.get<"Wide/Field00">() == 0 && wideCopy.get<"Wide/Field83">() == 83,
+         "84 entries decoded by name");
+  std::cout << "84 entries decoded" << std::endl;
+
+  return failures == 0 ? 0 : 1;
+}
@@ -11,8 +11,9 @@ class NamedData {
   static constexpr auto EntryName = "OtherData";
 
   void serialize(auto& serializer) const {
-    serializer.serialize(makeEntry<"Int">(_value), //
-                         makeEntry<"Str">(_name));
+    using std::cref;
+    serializer.serialize(makeEntry<"Int">(cref(_value)), //
+                         makeEntry<"Str">(cref(_name)));
   }
 
   void deserialize(auto& deserializer) {
@@ -29,9 +30,10 @@ class NamedData {
 class Data {
  public:
   void serialize(auto& serializer) const {
-    serializer.serialize(makeEntry<"Int">(_value), //
-                         makeEntry<"Str">(_name),
-                         makeEntry<"DataVec">(_otherData));
+    using std::cref;
+    serializer.serialize(makeEntry<"Int">(cref(_value)), //
+                         makeEntry<"Str">(cref(_name)),
+                         makeEntry<"DataVec">(cref(_otherData)));
   }
 
   void deserialize(auto& deserializer) {
@@ -6,6 +6,7 @@
 
 #include <QBuffer>
 #include <QString>
+#include <iostream>
 #include <memory>
 
 int main(void) {
@@ -4,17 +4,54 @@
 #include "serializer.hpp"
 #include "serializer/stdcio.hpp"
 
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+// Value only printable through its operator<<
+struct Point {
+  int x{};
+  int y{};
+};
+
+std::ostream& operator<<(std::ostream& out, const Point& point) {
+  return out << '(' << point.x << ", " << point.y << ')';
+}
+
+// Values StdCout prints in their own way
+auto make_printed_data() {
+  return makeEntry<"Printed">(std::tuple{
+    makeEntry<"Char">('x', makeAttr<"Next">('y')),
+    makeEntry<"Ratio">(0.1),
+    makeEntry<"Point">(Point{ 1, 2 }),
+  });
+}
+
 int main(void) {
   Serializer serializer(StdCout{});
   Deserializer deserializer(StdCin{});
 
   auto tree = make_data();
 
-  std::cout << "[stdcio] Serialization:" << std::endl;
+  std::cout << "[stdcio] Buffered serialization:" << std::endl;
+  std::ostringstream streamed;
+  auto* const output = std::cout.rdbuf(streamed.rdbuf());
+  serializer.serialize(tree, make_printed_data());
+  std::cout.rdbuf(output);
+  auto buffer = std::make_shared<std::string>();
+  Serializer bufferedSerializer(StdBufferedWriter(StringSink{ buffer }));
+  bufferedSerializer.serialize(tree, make_printed_data());
+  const bool identical = *buffer == streamed.str();
+  std::cout << (identical ? "identical" : "different") << " to StdCout" << std::endl;
+
+  std::cout << '\n' << "[stdcio] Serialization:" << std::endl;
   serializer.serialize(tree);
   std::cout << '\n' << "[stdcio] Deserialization:" << std::endl;
   deserializer.deserialize(tree);
 
   std::cout << '\n' << "[stdcio] Serialization:" << std::endl;
   serializer.serialize(tree);
+
+  return identical ? 0 : 1;
 }